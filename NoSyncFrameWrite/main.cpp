@@ -33,6 +33,32 @@
 #include <format>
 #include <array>
 #include <ranges>
+#include <numeric>
+#include <bit>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <memory_resource>
+#include <type_traits>
+#include <limits>
+#include <fstream>
+#include <string>
+#include <execution>
+#include <functional>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <sched.h>
+#endif
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h> // (SSE2: the convolution kernels.)
+#endif
 
 
 namespace // (Anonymous namespace)
@@ -55,6 +81,15 @@ namespace // (Anonymous namespace)
 	}
 
 
+	// Print the duration since a given start time, and the bandwidth of processing a given byte count over it.
+	static void PrintBandwidth(const std::chrono::time_point<std::chrono::steady_clock> start_time, const uint64_t byte_count)
+	{
+		const auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_time);
+		const double gb_per_s{ duration_us.count() > 0 ? static_cast<double>(byte_count) / (duration_us.count() * 1000.0) : 0.0 };
+		std::cout << "(execution time: " << duration_us.count() / 1000 << " milliseconds, bandwidth: " << std::format("{:.2f}", gb_per_s) << " GB/s)" << std::endl;
+	}
+
+
 	// Format a large character count with appropriate units (K, M, G, etc.)
 	std::string FormatCharCount(uint64_t char_count)
 	{
@@ -62,8 +97,8 @@ namespace // (Anonymous namespace)
 		const std::array<const char*, 9> units = { "", "K", "M", "G", "T", "P", "E", "Z", "Y" }; // (index 0-8)
 
 		// Calculate the appropriate unit index based on the number of characters:
-		// (std::min ensures the calculated unit index doesn't exceed the bounds of the units array.)
-		const int unit_index = std::min(static_cast<int>(std::log2(char_count) / 10), 8);
+		// (std::min ensures the calculated unit index doesn't exceed the bounds of the units array; 0 has no log2.)
+		const int unit_index = char_count == 0 ? 0 : std::min(static_cast<int>(std::log2(char_count) / 10), 8);
 
 		// Format the number with the appropriate unit:
 		return unit_index == 0 ? std::format("{}", char_count) : std::format("{}{}", char_count / std::pow(1024, unit_index), units[unit_index]);
@@ -72,339 +107,5466 @@ namespace // (Anonymous namespace)
 	// __Utility
 
 
-	//	Frame class: Represents a rectangular frame of characters.
-	//
-	//	buffer_ (std::unique_ptr<char[]>)                                	<-- Pointer to dynamically allocated memory.
-	//	+-------------------------------+-------------------------------|   
-	//	|                               |                               |	<-- Rows (size_t). See: GetRows().
-	//	+-------------------------------+-------------------------------|
-	//	|                               |                               |	<-- Cols (size_t). See: GetCols().
-	//	+-------------------------------+-------------------------------|
-	//	|       |       |       |       |       |       |       |       |	<-- Frame data (characters). See: GetDataIndex()
-	//	+-------+-------+-------+-------+-------+-------+-------+-------|
-	//	| ...   | ...   | ...   | ...   | ...   | ...   | ...   | ...   |
-	//	+-------+-------+-------+-------+-------+-------+-------+-------|
-	//
-	//	buffer_: Pointer to a dynamically allocated memory block holding the frame data.
-	//	- The first `sizeof(size_t)` bytes (typically 8 bytes on modern systems) store the number of rows.
-	//	- The next `sizeof(size_t)` bytes (typically 8 bytes on modern systems) store the number of columns.
-	//	- The remaining memory stores the frame data, with each character occupying 1 byte.
+	// Segments__
 
-	class Frame final
+	// The CPUs this process may actually run on (0: no limit found):
+	// hardware: std::thread::hardware_concurrency() (the host CPUs, also inside a container),
+	// affinity: the CPUs of the process affinity mask (e.g. taskset / cpuset),
+	// quota: the cgroup (v2 cpu.max / v1 cpu.cfs_quota_us) CPU quota, rounded up (e.g. docker --cpus).
+	// budget: the least of them (at least 1), used as the thread count limit. See: GetThreadBudget().
+	struct ThreadBudget final
 	{
-	public:
+		size_t hardware{ 0 }, affinity{ 0 }, quota{ 0 }, budget{ 1 };
+	};
 
-		// Struct to define a rectangle within the frame:
-		struct Rect final
-		{
-			size_t x1{ 0 }, y1{ 0 }, x2{ 0 }, y2{ 0 };
-		};
 
+#if defined(_WIN32)
 
-		// Constructor to create a frame with given dimensions:
-		Frame(const size_t rows, const size_t cols)
-		{
-			[[maybe_unused]] const auto create_ok{ Create(rows, cols) };
+	[[nodiscard]] static size_t GetAffinityCpuCount()
+	{
+		DWORD_PTR process_mask{ 0 }, system_mask{ 0 };
+		if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+			return 0;
 		}
 
+		return static_cast<size_t>(std::popcount(static_cast<uint64_t>(process_mask))); // (Of the process processor group.)
+	}
+
 
-		// Draw "White" if frame with optimized_n worker-threads.
-		bool Draw(const Rect& rect, const size_t n = 1) const
-		{
-			const size_t cols_to_draw{ (rect.y2 - rect.y1) + 1 };
+	// (A job object CPU rate limit is not read.)
+	[[nodiscard]] static size_t GetQuotaCpuCount()
+	{
+		return 0;
+	}
 
-			// Dynamic thread count optimization:
-			const size_t optimized_n = std::clamp(n, static_cast<size_t>(1), // Min.
-				std::min(cols_to_draw, static_cast<size_t>(std::thread::hardware_concurrency()))); // Max.
+#else
 
-			std::string note{ "main-thread" };
-			if (optimized_n > 1) {
-				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
-			}
+	[[nodiscard]] static size_t GetAffinityCpuCount()
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+			return 0;
+		}
 
-			const auto chars{ FormatCharCount((rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1)) };
-			std::cout << "draw (" << note << ") (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << chars << " chars)" << std::endl;
+		return static_cast<size_t>(CPU_COUNT(&set));
+	}
 
-			if (!DrawSanityChecks(rect)) {
-				std::cerr << "error: Draw() sanity check failed." << std::endl;
 
-				return false;
+	// The CPU quota of the cgroup of this process: v2 ("0::<path>" -> <path>/cpu.max: "<quota> <period>" or "max <period>"),
+	// or v1 ("<id>:...cpu...:<path>" -> cpu.cfs_quota_us / cpu.cfs_period_us; quota -1: no limit).
+	// (Inside a cgroup namespace the path is "/", and the files are at the cgroup mount root.)
+	[[nodiscard]] static size_t GetQuotaCpuCount()
+	{
+		const auto quota_cpus = [](const double quota, const double period) -> size_t {
+			return quota > 0.0 && period > 0.0 ? static_cast<size_t>(std::ceil(quota / period)) : 0;
+		};
+
+		std::ifstream cgroups{ "/proc/self/cgroup" };
+		std::string line;
+		while (std::getline(cgroups, line)) {
+			const size_t first{ line.find(':') }, second{ line.find(':', first + 1) };
+			if (first == std::string::npos || second == std::string::npos) {
+				continue;
 			}
 
-			const auto start_time = Now(); // <-- Start.
+			const std::string controllers{ line.substr(first + 1, second - first - 1) }, path{ line.substr(second + 1) };
+
+			if (controllers.empty()) { // v2:
+				for (const std::string& directory : { "/sys/fs/cgroup" + path, std::string{ "/sys/fs/cgroup" } }) {
+					std::ifstream cpu_max{ directory + "/cpu.max" };
+					std::string quota;
+					double period{ 0.0 };
+					if (cpu_max >> quota >> period) {
+						return quota == "max" ? 0 : quota_cpus(std::stod(quota), period);
+					}
+				}
+			}
+			else if (std::ranges::any_of(std::views::split(controllers, ','), [](const auto& controller) { return std::string_view{ controller.begin(), controller.end() } == "cpu"; })) { // v1:
+				for (const std::string& directory : { "/sys/fs/cgroup/" + controllers + path, "/sys/fs/cgroup/cpu" + path, std::string{ "/sys/fs/cgroup/cpu" } }) {
+					std::ifstream quota_file{ directory + "/cpu.cfs_quota_us" }, period_file{ directory + "/cpu.cfs_period_us" };
+					double quota{ 0.0 }, period{ 0.0 };
+					if ((quota_file >> quota) && (period_file >> period)) {
+						return quota_cpus(quota, period);
+					}
+				}
+			}
+		}
 
-			if (optimized_n > 1) { // Run with worker-threads:
-				std::vector<std::pair<size_t, size_t>> segments(optimized_n);
-				PrepareSegments(cols_to_draw, segments);
+		return 0;
+	}
 
-				std::vector<std::jthread> threads;
-				threads.reserve(optimized_n - 1);
+#endif
 
-				// (optimized_n - 1) worker threads:
-				for (unsigned int i = 0; i < optimized_n - 1; ++i) {
-					threads.emplace_back([&, i]() { DrawThread(rect, segments[i]); }); // This uses the default capture mode (&), capturing all variables by reference, except i, which is captured by value.
-				}
 
-				// + [main thread]:
-				DrawThread(rect, segments[optimized_n - 1]);
+	// The thread budget of this process (read once). See: ThreadBudget.
+	[[nodiscard]] static const ThreadBudget& GetThreadBudget()
+	{
+		static const ThreadBudget budget{ [] {
+			ThreadBudget budget{ std::thread::hardware_concurrency(), GetAffinityCpuCount(), GetQuotaCpuCount(), 0 };
 
-				for (auto& thread : threads) {
-					thread.join();
+			budget.budget = std::numeric_limits<size_t>::max();
+			for (const size_t limit : { budget.hardware, budget.affinity, budget.quota }) {
+				if (limit > 0) {
+					budget.budget = std::min(budget.budget, limit);
 				}
 			}
-			else { // Run with main-thread:
-				DrawThread(rect, { 0, rect.y2 - rect.y1 });
+			if (budget.budget == std::numeric_limits<size_t>::max()) {
+				budget.budget = 1;
 			}
 
-			PrintDuration(start_time); // <-- Finish.
+			return budget;
+		}() };
 
-			return true;
-		}
+		return budget;
+	}
 
 
-		// Print the frame.
-		// This is mainly for debug / demo.
-		// Usefull on small frame (~ up to 100 rows).
-		[[nodiscard]] bool PrintFrame() const
-		{
-			if (buffer_ == nullptr) { // Create() failed.
-				std::cerr << "error: PrintFrame() frame buffer is nullptr." << std::endl;
+	// Print the thread budget.
+	static void PrintThreadBudget()
+	{
+		const ThreadBudget& budget{ GetThreadBudget() };
+		std::cout << "thread budget: " << budget.budget << " (hardware concurrency: " << budget.hardware << ", affinity: " << budget.affinity
+			<< ", cgroup quota: " << (budget.quota > 0 ? std::to_string(budget.quota) : "none") << ")" << std::endl;
+	}
 
-				return false;
-			}
 
-			size_t start_p{ GetDataIndex() };
+	// Dynamic thread count optimization: at least 1, at most one thread per col and per CPU of the thread budget.
+	[[nodiscard]] static size_t OptimizeThreadCount(const size_t n, const size_t cols)
+	{
+		return std::clamp(n, static_cast<size_t>(1), // Min.
+			std::max(std::min(cols, GetThreadBudget().budget), static_cast<size_t>(1))); // Max.
+	}
 
-			std::cout << "frame" << std::endl;
-			for (size_t i = 0; i < GetCols(); ++i) {
-				std::span<char> char_span(&buffer_.get()[start_p], GetRows());
-				std::ranges::for_each(char_span, [](char c) { std::cout << ((c == 0) ? '0' : '1'); }); std::cout << std::endl;
-				start_p += GetRows();
+
+	// Assign a "segment" of cols_to_draw for each thread (so we don't need thread syncronization): 
+	static void PrepareSegments(const size_t cols_to_draw, std::vector<std::pair<size_t, size_t>>& segments)
+	{
+		// Calculate the size of each segment to evenly distribute the drawing workload among them.
+		// Calculate the remainder to handle cases where the number of columns to draw is not evenly divisible by the number of chunks.
+		const size_t segment_size{ cols_to_draw / segments.size() },
+			remainder = cols_to_draw % segments.size();
+
+		// Set the size of each segment based on the calculated segment size and distribute the remaining workload.
+		for (int i = 0; i < segments.size(); ++i) {
+			segments[i].first = segment_size;
+			if (i < remainder) {
+				++segments[i].first;
 			}
+		}
 
-			return true;
+		// Adjust the 'from' and 'to' indices of each segment to properly define their boundaries.
+		size_t temp{ 0 };
+		for (int i = 0; i < segments.size(); ++i) {
+			segments[i].second = (segments[i].first - 1) + temp;
+			segments[i].first = temp;
+			temp = segments[i].second + 1;
 		}
 
-	protected:
+		// Print segment loads:
+		int i{ 1 };
+		for (const auto& segment : segments) {
+			std::cout << "* thread " << i++ << ": col " << segment.first << " - " << segment.second << std::endl;
+		}
+	}
 
-		// Assign a "segment" of cols_to_draw for each thread (so we don't need thread syncronization): 
-		void PrepareSegments(const size_t cols_to_draw, std::vector<std::pair<size_t, size_t>>& segments) const
-		{
-			// Calculate the size of each segment to evenly distribute the drawing workload among them.
-			// Calculate the remainder to handle cases where the number of columns to draw is not evenly divisible by the number of chunks.
-			const size_t segment_size{ cols_to_draw / segments.size() },
-				remainder = cols_to_draw % segments.size();
 
-			// Set the size of each segment based on the calculated segment size and distribute the remaining workload.
-			for (int i = 0; i < segments.size(); ++i) {
-				segments[i].first = segment_size;
-				if (i < remainder) {
-					++segments[i].first;
-				}
-			}
+	// Assign a "segment" of cols_to_draw for each thread, in proportion to its weight (e.g. its core throughput):
+	// at least 1 col each, the rest split by the weights (largest remainder first).
+	static void PrepareWeightedSegments(const size_t cols_to_draw, const std::vector<double>& weights, std::vector<std::pair<size_t, size_t>>& segments)
+	{
+		const double total{ std::accumulate(weights.begin(), weights.end(), 0.0) };
+		const size_t extra{ cols_to_draw - segments.size() }; // (Over 1 col each; OptimizeThreadCount() keeps a thread per col at most.)
 
-			// Adjust the 'from' and 'to' indices of each segment to properly define their boundaries.
-			size_t temp{ 0 };
-			for (int i = 0; i < segments.size(); ++i) {
-				segments[i].second = (segments[i].first - 1) + temp;
-				segments[i].first = temp;
-				temp = segments[i].second + 1;
-			}
+		std::vector<size_t> sizes(segments.size(), 1);
+		std::vector<std::pair<double, size_t>> remainders(segments.size()); // (Remainder, segment.)
+		size_t assigned{ 0 };
+		for (size_t i = 0; i < segments.size(); ++i) {
+			const double share{ total > 0.0 ? extra * weights[i] / total : static_cast<double>(extra) / segments.size() };
+			sizes[i] += static_cast<size_t>(share);
+			assigned += static_cast<size_t>(share);
+			remainders[i] = { share - std::floor(share), i };
+		}
+		std::ranges::sort(remainders, std::greater{});
+		for (size_t i = 0; assigned < extra; ++i, ++assigned) {
+			++sizes[remainders[i % remainders.size()].second];
+		}
 
-			// Print segment loads:
-			int i{ 1 };
-			for (const auto& segment : segments) {
-				std::cout << "* thread " << i++ << ": col " << segment.first << " - " << segment.second << std::endl;
-			}
+		size_t from{ 0 };
+		for (size_t i = 0; i < segments.size(); ++i) {
+			segments[i] = { from, from + sizes[i] - 1 };
+			from += sizes[i];
+
+			std::cout << "* thread " << i + 1 << ": col " << segments[i].first << " - " << segments[i].second << " (weight: " << std::format("{:.2f}", weights[i]) << ")" << std::endl;
 		}
+	}
 
 
-		// Check that Draw() is feasible.
-		[[nodiscard]] bool DrawSanityChecks(const Rect& rect) const
+	//	SegmentWeights class: The relative throughput of each thread "slot" (the thread of segment i, pinned to the i-th CPU
+	//	of the affinity mask), for segments in proportion to it (e.g. hybrid P / E cores, mixed frequencies).
+	//
+	//	- Disabled by default (equal segments, threads not pinned). Calibrate() measures each CPU at startup (a fill
+	//	  benchmark, one CPU at a time) and enables it.
+	//	- Observing (optional): every run updates the weights (EWMA) from the time each slot took for its cols.
+	//	- Process-wide (Get()); thread safe.
+
+	class SegmentWeights final
+	{
+	public:
+
+		[[nodiscard]] static SegmentWeights& Get()
 		{
-			return (!(rect.x1 < 0 || rect.y1 < 0 // x1-y1 negative.
-				|| rect.x2 < rect.x1 || rect.y2 < rect.y1 // x1-y1 is beyond x2-y2.
-				|| rect.x2 > GetRows() - 1 || rect.y2 > GetCols() - 1 // x2-y2 is exceeds frame.
-				|| buffer_ == nullptr)); // Create() failed.
+			static SegmentWeights weights{};
+
+			return weights;
 		}
 
 
-		// (Run in the context of multiple threads; no syncronization! - SEGMENTS SHOULD NOT OVERLAP!)
-		// Draw segment. 
-		// segment is col from - to offsets (*relative to rect.y1*).
-		void DrawThread(const Rect& rect, std::pair<size_t, size_t> segment) const
+		// Measure the fill throughput of the first slots CPUs (of the affinity mask) and enable the weights.
+		void Calibrate(const size_t slots, const bool observe = true)
 		{
-			const auto id{ std::this_thread::get_id() };
+			std::vector<double> throughputs(std::max(slots, static_cast<size_t>(1)));
+			std::vector<char> buffer(8 * 1024 * 1024);
 
-			for (size_t i = segment.first; i <= segment.second; ++i) {
+			for (size_t i = 0; i < throughputs.size(); ++i) {
+				std::jthread{ [&, i]() {
+					const ScopedPin pin{ GetCpu(i) };
+					std::chrono::nanoseconds best{ std::chrono::nanoseconds::max() };
+					for (int repeat = 0; repeat < 5; ++repeat) {
+						const auto start_time = Now();
+						std::memset(buffer.data(), repeat, buffer.size());
+						std::atomic_signal_fence(std::memory_order_seq_cst); // (Keep each repeat's stores.)
+						best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time));
+					}
+					throughputs[i] = static_cast<double>(buffer.size()) / std::max<int64_t>(best.count(), 1);
+				} }; // (Joins here: one CPU at a time.)
+			}
 
-				// (GetDataIndex() is added only later. For easier envision while dev.)
-				size_t start_p{ (rect.x1 + (i + rect.y1) * GetRows()) }; // if y1 == 0, juts x1.
-				const size_t size_for_memset{ (rect.x2 - rect.x1) + 1 }; // if x2 == x1, 1 char.
+			const double mean{ std::accumulate(throughputs.begin(), throughputs.end(), 0.0) / throughputs.size() };
 
-				start_p += GetDataIndex();
- 
-				// (Each thread writes to an exclusive segments of the buffer => No need for mutex.)
-				std::span<char> char_span(&buffer_.get()[start_p], size_for_memset);
-				std::ranges::fill(char_span, 0x00); // Draw "White" (0x00).
+			std::scoped_lock lock{ mutex_ };
+			weights_.clear();
+			for (const double throughput : throughputs) {
+				weights_.push_back(throughput / mean);
 			}
+			enabled_ = true;
+			observe_ = observe;
 		}
 
 
-		// Create a blank frame.
-		[[nodiscard]] bool Create(const size_t rows, const size_t cols)
+		// Back to equal segments (threads not pinned).
+		void Disable()
 		{
-			// If rows and/or cols 0, return false. buffer_ stays nullptr.
-			if (!(rows > 0 && cols > 0)) {
-				std::cerr << "error: Create() rows and/or cols 0." << std::endl;
+			std::scoped_lock lock{ mutex_ };
+			enabled_ = false;
+		}
 
-				return false;
-			}
 
-			try
-			{
-				const size_t buffer_size{ GetDataIndex() + (cols * rows) };
-				buffer_ = std::unique_ptr<char[]>(new char[buffer_size]); // std::make_unique<char[]>(buffer_size); (As of C++20, std::make_unique does not support dynamic arrays)
+		[[nodiscard]] bool IsEnabled() const
+		{
+			std::scoped_lock lock{ mutex_ };
 
-				// Embeds rows and cols into buffer_:
-				std::memcpy(buffer_.get(), &rows, sizeof(size_t));
-				std::memcpy(buffer_.get() + sizeof(size_t), &cols, sizeof(size_t));
+			return enabled_;
+		}
 
-				// Initialize empty frame:
-				std::memset(buffer_.get() + GetDataIndex(), 0xFF, cols * rows); // Draw "Black" (0xFF).
 
-				std::cout << "create frame (rows: " << rows << ", cols: " << cols << ")" << std::endl;
-			}
-			catch ([[maybe_unused]] const std::bad_alloc& e)
-			{
-				// buffer_ stays nullptr.
-				return false;
-			}
+		// The weights of the first n slots (1.0 for the slots not measured).
+		[[nodiscard]] std::vector<double> GetWeights(const size_t n) const
+		{
+			std::scoped_lock lock{ mutex_ };
 
-			return true;
-		}
+			std::vector<double> weights(n, 1.0);
+			std::copy_n(weights_.begin(), std::min(n, weights_.size()), weights.begin());
 
+			return weights;
+		}
 
-		// Buffer indicators__
 
-		// Extract rows from the buffer.
-		[[nodiscard]] size_t GetRows() const
+		// Update the weights (EWMA) from the time each slot took for its segment (observing only).
+		void Observe(const std::vector<std::pair<size_t, size_t>>& segments, const std::vector<std::chrono::nanoseconds>& durations)
 		{
-			if (buffer_ == nullptr) { // Create() failed.
-				std::cerr << "error: GetRows() frame buffer is nullptr." << std::endl;
+			std::scoped_lock lock{ mutex_ };
+			if (!observe_) {
+				return;
+			}
 
-				return 0;
+			if (weights_.size() < segments.size()) {
+				weights_.resize(segments.size(), 1.0);
 			}
 
-			size_t rows{ 0 };
-			std::memcpy(&rows, buffer_.get(), sizeof(size_t));
+			// Throughput (cols / ns) relative to the mean of this run, scaled to the mean weight of its slots:
+			std::vector<double> throughputs(segments.size());
+			for (size_t i = 0; i < segments.size(); ++i) {
+				throughputs[i] = static_cast<double>(segments[i].second - segments[i].first + 1) / std::max<int64_t>(durations[i].count(), 1);
+			}
+			const double mean_throughput{ std::accumulate(throughputs.begin(), throughputs.end(), 0.0) / segments.size() };
+			const double mean_weight{ std::accumulate(weights_.begin(), weights_.begin() + segments.size(), 0.0) / segments.size() };
 
-			return rows;
+			for (size_t i = 0; i < segments.size(); ++i) {
+				weights_[i] += kAlpha * (mean_weight * throughputs[i] / mean_throughput - weights_[i]);
+			}
 		}
 
 
-		// Extract cols from the buffer .
-		[[nodiscard]] size_t GetCols() const
+		// The CPU of slot i: the i-th CPU of the affinity mask (wrapping around).
+		[[nodiscard]] size_t GetCpu(const size_t slot) const
 		{
-			if (buffer_ == nullptr) { // Create() failed.
-				std::cerr << "error: GetCols() frame buffer is nullptr." << std::endl;
+			return cpus_.empty() ? 0 : cpus_[slot % cpus_.size()];
+		}
 
-				return 0;
+
+		// Pin the current thread to a CPU while in scope (restoring its affinity after).
+		class ScopedPin final
+		{
+		public:
+
+#if defined(_WIN32)
+			explicit ScopedPin(const size_t cpu) : previous_{ SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) } {}
+			~ScopedPin() { if (previous_ != 0) { SetThreadAffinityMask(GetCurrentThread(), previous_); } }
+#else
+			explicit ScopedPin(const size_t cpu)
+			{
+				pinned_ = pthread_getaffinity_np(pthread_self(), sizeof(previous_), &previous_) == 0;
+
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpu, &set);
+				pinned_ = pinned_ && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
 			}
+			~ScopedPin() { if (pinned_) { pthread_setaffinity_np(pthread_self(), sizeof(previous_), &previous_); } }
+#endif
 
-			size_t cols{ 0 };
-			std::memcpy(&cols, buffer_.get() + sizeof(size_t), sizeof(size_t));
+			ScopedPin(const ScopedPin&) = delete;
+			ScopedPin& operator=(const ScopedPin&) = delete;
 
-			return cols;
-		}
+		private:
 
+#if defined(_WIN32)
+			const DWORD_PTR previous_;
+#else
+			cpu_set_t previous_{};
+			bool pinned_{ false };
+#endif
+		};
 
-		// Return the index where the frame begins.
-		[[nodiscard]] constexpr size_t GetDataIndex() const // The result is computed during compilation.
+	private:
+
+		static constexpr double kAlpha{ 0.25 }; // (EWMA.)
+
+
+		SegmentWeights() : cpus_{ GetAffinityCpus() } {}
+
+
+		// The CPUs of the process affinity mask.
+		[[nodiscard]] static std::vector<size_t> GetAffinityCpus()
 		{
-			return sizeof(size_t) * 2;
+			std::vector<size_t> cpus;
+#if defined(_WIN32)
+			DWORD_PTR process_mask{ 0 }, system_mask{ 0 };
+			if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+				for (size_t cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu) {
+					if (process_mask & (static_cast<DWORD_PTR>(1) << cpu)) {
+						cpus.push_back(cpu);
+					}
+				}
+			}
+#else
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+				for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+					if (CPU_ISSET(cpu, &set)) {
+						cpus.push_back(cpu);
+					}
+				}
+			}
+#endif
+			return cpus;
 		}
 
-		// __Buffer indicators
 
+		const std::vector<size_t> cpus_;
 
-		std::unique_ptr<char[]> buffer_{}; // [rows][cols][....frame data....]
+		mutable std::mutex mutex_{};
+		std::vector<double> weights_{};
+		bool enabled_{ false }, observe_{ false };
 	};
 
 
-	// Let's visually confirm that it is functioning correctly. 
-	static void TestFunctionality()
+	//	SpinParkBarrier class: A one-waiter completion barrier: Reset(count) before a run, Arrive() by each of the count
+	//	participants, Wait() by the waiter until all arrived.
+	//
+	//	- Wait() spins first (up to the spin budget, a CPU pause each), then parks (atomic::wait: a futex / WaitOnAddress).
+	//	  Short runs complete while spinning (no sleep / wake up); long runs don't burn a CPU.
+	//	- Arrive() notifies only if the waiter parked (no syscall otherwise).
+
+	class SpinParkBarrier final
 	{
-		std::cout << "**** test functionality: small frame + small draw + print frame: ****\n" << std::endl;
+	public:
 
-		std::vector<std::pair<size_t, size_t>> xy_sets{ { 10, 15 } /* Possible to add here more frames */ };
-		for (const auto& xy : xy_sets)
+		static constexpr size_t kDefaultSpinBudget{ 4096 };
+
+
+		// Counters of the waits:
+		struct Stats final
 		{
-			Frame frame{ xy.first, xy.second };
-			std::cout << std::endl;
+			size_t waits{ 0 }; // Wait() calls.
+			size_t spun{ 0 }; // Completed while spinning.
+			size_t parked{ 0 }; // Parked.
+		};
 
-			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 3, 2 }) };
-			std::cout << std::endl;
 
-			ok = frame.PrintFrame();
-			std::cout << std::endl;
+		explicit SpinParkBarrier(const size_t spin_budget = kDefaultSpinBudget) : spin_budget_{ spin_budget } {}
 
-			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
-			std::cout << std::endl;
+		SpinParkBarrier(const SpinParkBarrier&) = delete;
+		SpinParkBarrier& operator=(const SpinParkBarrier&) = delete;
 
-			ok = frame.PrintFrame();
-			std::cout << std::endl;
+
+		// Expect count arrivals (no arrival or wait in progress).
+		void Reset(const size_t count)
+		{
+			parked_.store(false, std::memory_order_relaxed);
+			pending_.store(count, std::memory_order_release);
 		}
-	}
 
 
-	// Let's assess the performance on a very large frame with a different thread count.
-	static void TestPerformance()
-	{
-		std::cout << "**** test performance (hardware concurrency: " << std::thread::hardware_concurrency() << "): large frame + large draw: ****\n" << std::endl;
+		void Arrive()
+		{
+			if (pending_.fetch_sub(1, std::memory_order_seq_cst) == 1 && parked_.load(std::memory_order_seq_cst)) {
+				pending_.notify_one();
+			}
+		}
 
-		constexpr size_t kFrameRows = 600000;
-		constexpr size_t kFrameCols = 2000;
 
-		// 512MB
-		constexpr size_t kDrawRows = 524288; // 512KB
-		constexpr size_t kDrawCols = 1024; // 1KB
+		// Wait until all arrived: spin (if spin), then park.
+		void Wait(const bool spin = true)
+		{
+			waits_.fetch_add(1, std::memory_order_relaxed);
 
-		Frame frame{ kFrameRows, kFrameCols };
-		std::cout << std::endl;
+			const size_t spin_budget{ spin ? spin_budget_.load(std::memory_order_relaxed) : 0 };
+			for (size_t iteration = 0; iteration < spin_budget; ++iteration) {
+				if (pending_.load(std::memory_order_acquire) == 0) {
+					spun_.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				CpuPause();
+			}
 
-		{
-			size_t buffer_size{ static_cast<size_t>(kDrawRows) * kDrawCols }; // Cast sub-expr. to a wider type.
+			parked_.store(true, std::memory_order_seq_cst); // (Before the last check: the last Arrive() sees it, or we see 0.)
+			bool parked{ false };
+			for (size_t pending = pending_.load(std::memory_order_seq_cst); pending != 0; pending = pending_.load(std::memory_order_acquire)) {
+				pending_.wait(pending, std::memory_order_acquire);
+				parked = true;
+			}
+			(parked ? parked_count_ : spun_).fetch_add(1, std::memory_order_relaxed);
+		}
 
-			std::cout << "benchmark: std::memcpy of " << buffer_size << " bytes" << std::endl;
 
-			auto start_time = Now(); // <-- Start.
+		void SetSpinBudget(const size_t spin_budget)
+		{
+			spin_budget_.store(spin_budget, std::memory_order_relaxed);
+		}
 
-			// Benchmark:
-			auto buffer = std::unique_ptr<char[]>(new char[buffer_size]);
-			std::memset(buffer.get(), '0', buffer_size);
 
-			PrintDuration(start_time); // <-- Finish.
-			std::cout << std::endl;
+		[[nodiscard]] size_t GetSpinBudget() const
+		{
+			return spin_budget_.load(std::memory_order_relaxed);
 		}
 
-		[[maybe_unused]] bool ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 1);
-		std::cout << std::endl;
 
-		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 2);
-		std::cout << std::endl;
+		[[nodiscard]] Stats GetStats() const
+		{
+			return { waits_.load(std::memory_order_relaxed), spun_.load(std::memory_order_relaxed), parked_count_.load(std::memory_order_relaxed) };
+		}
 
-		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 4);
-		std::cout << std::endl;
 
-		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 8);
-		std::cout << std::endl;
+		void ResetStats()
+		{
+			waits_.store(0, std::memory_order_relaxed);
+			spun_.store(0, std::memory_order_relaxed);
+			parked_count_.store(0, std::memory_order_relaxed);
+		}
 
-		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 12);
-		std::cout << std::endl;
-	}
+	private:
 
-} // (Anonymous namespace)
+		// A spin-wait hint to the CPU (saves power, and yields to the sibling hyperthread).
+		static void CpuPause()
+		{
+#if defined(_WIN32)
+			YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+
+		std::atomic<size_t> pending_{ 0 };
+		std::atomic<bool> parked_{ false };
+		std::atomic<size_t> spin_budget_;
+
+		std::atomic<size_t> waits_{ 0 }, spun_{ 0 }, parked_count_{ 0 };
+	};
+
+
+	//	WorkerPool class: Persistent worker threads for the segments (instead of a jthread per segment per draw).
+	//
+	//	- Run(n, function): function(i) for i 0 - (n - 2) on the workers, and (n - 1) on the calling thread.
+	//	- The workers are created on demand (up to the largest n so far) and wait on an atomic (atomic::wait) between runs.
+	//	- The calling thread waits for the workers on a SpinParkBarrier (see SetSpinBudget()); it spins only if each thread
+	//	  of the run has a CPU (see GetThreadBudget()).
+	//	- One run at a time: TryRun() returns false if the pool is busy (another thread's run, or a run from within a run),
+	//	  so the caller can fall back to its own threads.
+	//	- Process-wide (Get()); thread safe.
+
+	class WorkerPool final
+	{
+	public:
+
+		[[nodiscard]] static WorkerPool& Get()
+		{
+			static WorkerPool pool{};
+
+			return pool;
+		}
+
+
+		~WorkerPool()
+		{
+			stopping_.store(true, std::memory_order_relaxed);
+			job_.fetch_add(kGeneration, std::memory_order_release);
+			job_.notify_all();
+
+			// (Join here: the workers use the other members, which are destroyed before workers_.)
+			for (auto& worker : workers_) {
+				worker.join();
+			}
+		}
+
+
+		// Run function(i) for i 0 - (n - 1); false if the pool is busy (nothing was run).
+		template<typename Function>
+		[[nodiscard]] bool TryRun(const size_t n, Function&& function)
+		{
+			bool& in_run{ InRun() };
+			if (in_run || n - 1 > kMaxWorkers) { // (A run from within this thread's own share: it owns run_mutex_ already.)
+				return false;
+			}
+
+			std::unique_lock lock{ run_mutex_, std::try_to_lock };
+			if (!lock.owns_lock()) {
+				return false;
+			}
+
+			// (While this thread runs its share and waits for the workers.)
+			in_run = true;
+			struct InRunGuard final { bool& in_run; ~InRunGuard() { in_run = false; } } const in_run_guard{ in_run };
+
+			while (workers_.size() < n - 1) { // (From the current job on: the new job is the next one they see.)
+				workers_.emplace_back([this, index = workers_.size(), job = job_.load(std::memory_order_relaxed)]() { Work(index, job); });
+			}
+
+			// Publish the job (the workers read it once they see the new job_ value):
+			invoke_ = [](void* context, const size_t i) { (*static_cast<std::remove_reference_t<Function>*>(context))(i); };
+			context_ = const_cast<void*>(static_cast<const void*>(&function));
+			completion_.Reset(n - 1);
+			job_.store((job_.load(std::memory_order_relaxed) & ~kWorkerMask) + kGeneration + (n - 1), std::memory_order_release);
+			job_.notify_all();
+
+			// + [calling thread]:
+			function(n - 1);
+
+			if (n > 1) { // (More threads than CPUs: the workers need this CPU, park right away.)
+				completion_.Wait(n <= GetThreadBudget().budget);
+			}
+
+			return true;
+		}
+
+
+		[[nodiscard]] size_t GetWorkerCount() const
+		{
+			std::scoped_lock lock{ run_mutex_ };
+
+			return workers_.size();
+		}
+
+
+		// How long the calling thread spins for the workers before it parks (CPU pauses; 0: park right away).
+		void SetSpinBudget(const size_t spin_budget)
+		{
+			completion_.SetSpinBudget(spin_budget);
+		}
+
+
+		[[nodiscard]] SpinParkBarrier& GetCompletion()
+		{
+			return completion_;
+		}
+
+	private:
+
+		// job_: the generation (upper bits) and the worker count of the current job (lower bits).
+		static constexpr uint64_t kWorkerMask{ 0xFFFF }, kGeneration{ kWorkerMask + 1 };
+		static constexpr size_t kMaxWorkers{ kWorkerMask };
+
+
+		WorkerPool() = default;
+
+
+		// Is the current thread within a TryRun() (as its calling thread)? (Not a template: one flag for all the runs.)
+		[[nodiscard]] static bool& InRun()
+		{
+			thread_local bool in_run{ false };
+
+			return in_run;
+		}
+
+
+		void Work(const size_t index, uint64_t job)
+		{
+			for (;;) {
+				job_.wait(job, std::memory_order_acquire);
+				job = job_.load(std::memory_order_acquire);
+
+				if (stopping_.load(std::memory_order_relaxed)) {
+					return;
+				}
+
+				if (index < (job & kWorkerMask)) { // (A worker of this job.)
+					invoke_(context_, index);
+					completion_.Arrive();
+				}
+			}
+		}
+
+
+		mutable std::mutex run_mutex_{};
+		std::vector<std::jthread> workers_{};
+
+		std::atomic<uint64_t> job_{ 0 };
+		SpinParkBarrier completion_{};
+		std::atomic<bool> stopping_{ false };
+		void (*invoke_)(void*, size_t) { nullptr };
+		void* context_{ nullptr };
+	};
+
+
+	// Execution backend of the segments (process-wide, see SetExecutionBackend()):
+	// - kThreads: a jthread per segment (and the main thread), created per run.
+	// - kPool: the persistent WorkerPool (kThreads when the pool is busy).
+	// - kParallelAlgorithms: std::for_each(std::execution::par) over the segments (the standard library's pool; not unseq: the runs use atomics, syscalls and callbacks).
+	// - kOpenMP: an OpenMP parallel for over the segments (if built with OpenMP, e.g. /openmp or -fopenmp).
+	enum class ExecutionBackend : char { kThreads = 0, kPool = 1, kParallelAlgorithms = 2, kOpenMP = 3 };
+
+
+	[[nodiscard]] static const char* GetBackendName(const ExecutionBackend backend)
+	{
+		switch (backend) {
+		case ExecutionBackend::kPool: return "worker pool";
+		case ExecutionBackend::kParallelAlgorithms: return "parallel algorithms";
+		case ExecutionBackend::kOpenMP: return "openmp";
+		default: return "threads";
+		}
+	}
+
+
+	// Is the backend available in this build?
+	[[nodiscard]] static constexpr bool IsBackendAvailable(const ExecutionBackend backend)
+	{
+		switch (backend) {
+		case ExecutionBackend::kParallelAlgorithms:
+#if defined(__cpp_lib_parallel_algorithm)
+			return true;
+#else
+			return false;
+#endif
+		case ExecutionBackend::kOpenMP:
+#if defined(_OPENMP)
+			return true;
+#else
+			return false;
+#endif
+		default:
+			return true;
+		}
+	}
+
+
+	[[nodiscard]] static std::atomic<ExecutionBackend>& CurrentExecutionBackend()
+	{
+		static std::atomic<ExecutionBackend> backend{ ExecutionBackend::kThreads };
+
+		return backend;
+	}
+
+
+	[[nodiscard]] static ExecutionBackend GetExecutionBackend()
+	{
+		return CurrentExecutionBackend().load(std::memory_order_relaxed);
+	}
+
+
+	// Select the execution backend of the segments (for all frames).
+	static bool SetExecutionBackend(const ExecutionBackend backend)
+	{
+		if (!IsBackendAvailable(backend)) {
+			std::cerr << "error: SetExecutionBackend() " << GetBackendName(backend) << " is not available in this build." << std::endl;
+
+			return false;
+		}
+
+		CurrentExecutionBackend().store(backend, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	// Run run(i) for i 0 - (n - 1) in parallel, on the execution backend.
+	// (The runs must not wait for each other: the parallel algorithms and OpenMP give no forward progress guarantee between them.)
+	template<typename Run>
+	static void RunParallel(const size_t n, Run&& run)
+	{
+		switch (GetExecutionBackend()) {
+		case ExecutionBackend::kPool:
+			if (WorkerPool::Get().TryRun(n, run)) {
+				return;
+			}
+			break; // (Busy: threads.)
+
+		case ExecutionBackend::kParallelAlgorithms: {
+#if defined(__cpp_lib_parallel_algorithm)
+			std::vector<size_t> indices(n);
+			std::iota(indices.begin(), indices.end(), static_cast<size_t>(0));
+			std::for_each(std::execution::par, indices.begin(), indices.end(), run);
+			return;
+#else
+			break;
+#endif
+		}
+
+		case ExecutionBackend::kOpenMP: {
+#if defined(_OPENMP)
+			const int64_t count{ static_cast<int64_t>(n) };
+#pragma omp parallel for num_threads(static_cast<int>(n)) schedule(static, 1)
+			for (int64_t i = 0; i < count; ++i) {
+				run(static_cast<size_t>(i));
+			}
+			return;
+#else
+			break;
+#endif
+		}
+
+		default:
+			break;
+		}
+
+		std::vector<std::jthread> threads;
+		threads.reserve(n - 1);
+
+		// (n - 1) worker threads:
+		for (size_t i = 0; i < n - 1; ++i) {
+			threads.emplace_back([&, i]() { run(i); }); // This uses the default capture mode (&), capturing all variables by reference, except i, which is captured by value.
+		}
+
+		// + [main thread]:
+		run(n - 1);
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+
+
+	// Run function(segment index, segment) over cols 0 - (cols - 1), split into optimized_n segments:
+	// (optimized_n - 1) worker threads + the main thread (on the execution backend, see RunParallel()).
+	// (With SegmentWeights enabled: weighted segments, each thread pinned to its slot CPU, and the run observed.)
+	template<typename Function>
+	static void RunSegments(const size_t cols, const size_t optimized_n, Function&& function)
+	{
+		if (optimized_n > 1) { // Run with worker-threads:
+			SegmentWeights& weights{ SegmentWeights::Get() };
+			const bool weighted{ weights.IsEnabled() };
+
+			std::vector<std::pair<size_t, size_t>> segments(optimized_n);
+			if (weighted) {
+				PrepareWeightedSegments(cols, weights.GetWeights(optimized_n), segments);
+			}
+			else {
+				PrepareSegments(cols, segments);
+			}
+
+			std::vector<std::chrono::nanoseconds> durations(optimized_n);
+			const auto run = [&](const size_t i) {
+				if (!weighted) {
+					function(i, segments[i]);
+					return;
+				}
+
+				const SegmentWeights::ScopedPin pin{ weights.GetCpu(i) };
+				const auto start_time = Now();
+				function(i, segments[i]);
+				durations[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time);
+			};
+
+			RunParallel(optimized_n, run);
+
+			if (weighted) {
+				weights.Observe(segments, durations);
+			}
+		}
+		else { // Run with main-thread:
+			function(0, { 0, cols - 1 });
+		}
+	}
+
+	// Scheduling of the cols among the threads:
+	// - kStatic: a segment per thread (PrepareSegments()), no synchronization at all.
+	// - kDynamic: each thread grabs fixed size chunks from a shared atomic cursor (the faster threads take more chunks).
+	// - kGuided: as kDynamic, with decreasing chunk sizes (the remaining cols / (2 * threads)): big chunks first, small at the end.
+	// The chunks are disjoint (writes never overlap), only the cursor is shared.
+	enum class SegmentSchedule : char { kStatic = 0, kDynamic = 1, kGuided = 2 };
+
+
+	[[nodiscard]] static const char* GetScheduleName(const SegmentSchedule schedule)
+	{
+		switch (schedule) {
+		case SegmentSchedule::kDynamic: return "dynamic";
+		case SegmentSchedule::kGuided: return "guided";
+		default: return "static";
+		}
+	}
+
+
+	// Run function(thread index, chunk) over cols 0 - (cols - 1) with optimized_n threads, scheduled as schedule.
+	// (As RunSegments() with kStatic; otherwise function may be called several times per thread, with disjoint chunks.)
+	template<typename Function>
+	static void RunChunks(const size_t cols, const size_t optimized_n, const SegmentSchedule schedule, Function&& function)
+	{
+		if (schedule == SegmentSchedule::kStatic || optimized_n <= 1) {
+			RunSegments(cols, optimized_n, std::forward<Function>(function));
+			return;
+		}
+
+		const size_t dynamic_chunk{ std::max(cols / (optimized_n * 16), static_cast<size_t>(1)) }; // (~16 chunks per thread.)
+		std::atomic<size_t> cursor{ 0 };
+
+		// Grab the next chunk (empty when done):
+		const auto next_chunk = [&]() -> std::pair<size_t, size_t> {
+			if (schedule == SegmentSchedule::kDynamic) {
+				const size_t from{ cursor.fetch_add(dynamic_chunk, std::memory_order_relaxed) };
+				return { std::min(from, cols), std::min(from + dynamic_chunk, cols) };
+			}
+
+			size_t from{ cursor.load(std::memory_order_relaxed) }, to{ 0 };
+			do {
+				if (from >= cols) {
+					return { cols, cols };
+				}
+				to = from + std::max((cols - from) / (optimized_n * 2), static_cast<size_t>(1));
+			} while (!cursor.compare_exchange_weak(from, to, std::memory_order_relaxed));
+
+			return { from, to };
+		};
+
+		const auto run = [&](const size_t i) {
+			for (auto [from, to] = next_chunk(); from < to; std::tie(from, to) = next_chunk()) {
+				function(i, std::pair<size_t, size_t>{ from, to - 1 });
+			}
+		};
+
+		RunParallel(optimized_n, run);
+	}
+
+	// __Segments
+
+
+	//	PageResource class: A std::pmr::memory_resource that maps whole pages straight from the OS (mmap / VirtualAlloc).
+	//
+	//	- kHugePages: huge (large) pages; falls back to regular pages (+ transparent huge pages hint on Linux) when unavailable.
+	//	- kLocked: the pages are locked in RAM ("pinned"); best effort (limited by RLIMIT_MEMLOCK / the working set size).
+	//	- kShared: a shared mapping (inherited shared by forked processes on Linux; a pagefile-backed section on Windows).
+	//	- Alignment up to the page size (every allocation starts on a page).
+
+	class PageResource final : public std::pmr::memory_resource
+	{
+	public:
+
+		enum Flags : unsigned { kNone = 0, kHugePages = 1, kLocked = 2, kShared = 4 };
+
+
+		explicit PageResource(const unsigned flags = kNone) : flags_{ flags } {}
+
+
+		// Zero size bytes at p (memory allocated from this resource), by giving the whole pages back to the OS: they come
+		// back as zero pages on the next touch (the partial pages at the edges are zeroed in place).
+		// False if the pages cannot be given back (shared / huge / locked pages): p is left as is.
+		bool Discard(char* p, const size_t size) const
+		{
+			if (flags_ & (kShared | kHugePages | kLocked)) { // (Shared pages keep their content; huge / locked pages cannot be discarded per page.)
+				return false;
+			}
+
+			const size_t page_size{ GetPageSize() };
+			const auto address{ reinterpret_cast<uintptr_t>(p) };
+			char* const first_page{ p + (RoundUp(address, page_size) - address) };
+			char* const last_page{ p + ((address + size) / page_size * page_size - address) };
+			if (first_page >= last_page) { // (No whole page.)
+				std::memset(p, 0x00, size);
+
+				return true;
+			}
+
+			if (!Decommit(first_page, static_cast<size_t>(last_page - first_page))) {
+				return false;
+			}
+			std::memset(p, 0x00, static_cast<size_t>(first_page - p));
+			std::memset(last_page, 0x00, static_cast<size_t>(p + size - last_page));
+
+			return true;
+		}
+
+	protected:
+
+		void* do_allocate(const size_t bytes, const size_t alignment) override
+		{
+			if (alignment > GetPageSize()) {
+				std::cerr << "error: PageResource alignment beyond the page size." << std::endl;
+
+				throw std::bad_alloc();
+			}
+
+			const size_t size{ RoundUp(bytes, (flags_ & kHugePages) ? GetHugePageSize() : GetPageSize()) };
+			void* p{ Map(size) };
+			if (p == nullptr) {
+				throw std::bad_alloc();
+			}
+
+			if ((flags_ & kLocked) && !Lock(p, size)) {
+				std::cerr << "warning: PageResource could not lock " << FormatCharCount(size) << " bytes (not pinned)." << std::endl;
+			}
+
+			return p;
+		}
+
+
+		void do_deallocate(void* p, const size_t bytes, [[maybe_unused]] const size_t alignment) override
+		{
+			Unmap(p, RoundUp(bytes, (flags_ & kHugePages) ? GetHugePageSize() : GetPageSize()));
+		}
+
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+	private:
+
+		[[nodiscard]] static size_t RoundUp(const size_t bytes, const size_t unit)
+		{
+			return ((bytes + unit - 1) / unit) * unit;
+		}
+
+#if defined(_WIN32)
+
+		[[nodiscard]] static size_t GetPageSize()
+		{
+			SYSTEM_INFO info{};
+			GetSystemInfo(&info);
+
+			return info.dwPageSize;
+		}
+
+
+		[[nodiscard]] static size_t GetHugePageSize()
+		{
+			const size_t size{ GetLargePageMinimum() };
+
+			return size > 0 ? size : GetPageSize();
+		}
+
+
+		// (Large pages need the "Lock pages in memory" privilege; the regular pages fallback is taken otherwise.)
+		[[nodiscard]] void* Map(const size_t size) const
+		{
+			if (flags_ & kShared) {
+				const DWORD high{ static_cast<DWORD>(static_cast<uint64_t>(size) >> 32) }, low{ static_cast<DWORD>(size & 0xFFFFFFFF) };
+				HANDLE mapping{ CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | ((flags_ & kHugePages) ? SEC_LARGE_PAGES | SEC_COMMIT : 0), high, low, nullptr) };
+				if (mapping == nullptr && (flags_ & kHugePages)) {
+					mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, high, low, nullptr);
+				}
+				if (mapping == nullptr) {
+					return nullptr;
+				}
+
+				void* p{ MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) };
+				CloseHandle(mapping); // (The view keeps the section alive.)
+
+				return p;
+			}
+
+			void* p{ nullptr };
+			if (flags_ & kHugePages) {
+				p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			}
+
+			return p != nullptr ? p : VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		}
+
+
+		void Unmap(void* p, [[maybe_unused]] const size_t size) const
+		{
+			if (flags_ & kShared) {
+				UnmapViewOfFile(p);
+			}
+			else {
+				VirtualFree(p, 0, MEM_RELEASE);
+			}
+		}
+
+
+		[[nodiscard]] static bool Lock(void* p, const size_t size)
+		{
+			return VirtualLock(p, size) != FALSE;
+		}
+
+
+		// (Decommitted pages are zero when committed again.)
+		[[nodiscard]] static bool Decommit(void* p, const size_t size)
+		{
+			return VirtualFree(p, size, MEM_DECOMMIT) != FALSE && VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+		}
+
+#else
+
+		[[nodiscard]] static size_t GetPageSize()
+		{
+			return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		}
+
+
+		[[nodiscard]] static size_t GetHugePageSize()
+		{
+			return 2 * 1024 * 1024; // (The default huge page size on x86-64 / arm64.)
+		}
+
+
+		// (MAP_HUGETLB needs reserved huge pages; the regular pages + MADV_HUGEPAGE fallback is taken otherwise.)
+		[[nodiscard]] void* Map(const size_t size) const
+		{
+			const int flags{ ((flags_ & kShared) ? MAP_SHARED : MAP_PRIVATE) | MAP_ANONYMOUS };
+
+			void* p{ MAP_FAILED };
+#if defined(MAP_HUGETLB)
+			if (flags_ & kHugePages) {
+				p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+			}
+#endif
+			if (p == MAP_FAILED) {
+				p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+#if defined(MADV_HUGEPAGE)
+				if (p != MAP_FAILED && (flags_ & kHugePages)) {
+					madvise(p, size, MADV_HUGEPAGE);
+				}
+#endif
+			}
+
+			return p != MAP_FAILED ? p : nullptr;
+		}
+
+
+		static void Unmap(void* p, const size_t size)
+		{
+			munmap(p, size);
+		}
+
+
+		[[nodiscard]] static bool Lock(void* p, const size_t size)
+		{
+			return mlock(p, size) == 0;
+		}
+
+
+		// (Private anonymous pages are zero-fill-on-demand after MADV_DONTNEED.)
+		[[nodiscard]] static bool Decommit(void* p, const size_t size)
+		{
+			return madvise(p, size, MADV_DONTNEED) == 0;
+		}
+
+#endif
+
+		const unsigned flags_;
+	};
+
+
+	// Deleter of a frame buffer: returns it to the memory resource it was allocated from.
+	// (resource nullptr: borrowed memory, owned elsewhere; nothing to return. See: Frame::Adopt().)
+	struct BufferDeleter final
+	{
+		std::pmr::memory_resource* resource{ nullptr };
+		size_t size{ 0 }, alignment{ alignof(std::max_align_t) };
+
+		void operator()(char* buffer) const
+		{
+			if (resource != nullptr) {
+				resource->deallocate(buffer, size, alignment);
+			}
+		}
+	};
+
+
+	// Struct to define a rectangle within a frame (rows x1 - x2, cols y1 - y2, inclusive). See: Frame::Rect.
+	struct FrameRect final
+	{
+		size_t x1{ 0 }, y1{ 0 }, x2{ 0 }, y2{ 0 };
+	};
+
+
+	// The chars of rect (x1-y1 not beyond x2-y2), saturated at the max (a rect may extend far beyond a frame, e.g.
+	// { 0, 0, SIZE_MAX, SIZE_MAX }: its extents and their product overflow).
+	[[nodiscard]] static uint64_t GetRectChars(const FrameRect& rect)
+	{
+		constexpr uint64_t kMax{ std::numeric_limits<uint64_t>::max() };
+		const uint64_t rows{ rect.x2 - rect.x1 == kMax ? kMax : static_cast<uint64_t>(rect.x2 - rect.x1) + 1 };
+		const uint64_t cols{ rect.y2 - rect.y1 == kMax ? kMax : static_cast<uint64_t>(rect.y2 - rect.y1) + 1 };
+
+		return rows > kMax / cols ? kMax : rows * cols;
+	}
+
+
+	// Intersect rects a and b into intersection (false if they do not overlap).
+	[[nodiscard]] static bool IntersectRects(const FrameRect& a, const FrameRect& b, FrameRect& intersection)
+	{
+		if (a.x2 < b.x1 || a.x1 > b.x2 || a.y2 < b.y1 || a.y1 > b.y2) {
+			return false;
+		}
+
+		intersection = { std::max(a.x1, b.x1), std::max(a.y1, b.y1), std::min(a.x2, b.x2), std::min(a.y2, b.y2) };
+
+		return true;
+	}
+
+
+	// Subtract from each rect what later rects (of rects, in order) overwrite: disjoint rects covering the same chars.
+	// A - B splits into up to 4 rects: the cols of A before / after B (whole A rows: contiguous), and the rows of A
+	// above / below B within B's cols.
+	[[nodiscard]] static std::vector<FrameRect> SubtractRects(const std::span<const FrameRect> rects)
+	{
+		std::vector<FrameRect> disjoint, pieces, remaining;
+		for (auto it = rects.rbegin(); it != rects.rend(); ++it) { // (Latest first: it is not overwritten.)
+			pieces.assign(1, *it);
+
+			for (const FrameRect& later : disjoint) {
+				remaining.clear();
+				for (const FrameRect& piece : pieces) {
+					if (later.x2 < piece.x1 || later.x1 > piece.x2 || later.y2 < piece.y1 || later.y1 > piece.y2) {
+						remaining.push_back(piece); // (No overlap.)
+						continue;
+					}
+
+					const size_t y1{ std::max(piece.y1, later.y1) }, y2{ std::min(piece.y2, later.y2) };
+					if (piece.y1 < later.y1) {
+						remaining.push_back({ piece.x1, piece.y1, piece.x2, later.y1 - 1 });
+					}
+					if (piece.y2 > later.y2) {
+						remaining.push_back({ piece.x1, later.y2 + 1, piece.x2, piece.y2 });
+					}
+					if (piece.x1 < later.x1) {
+						remaining.push_back({ piece.x1, y1, later.x1 - 1, y2 });
+					}
+					if (piece.x2 > later.x2) {
+						remaining.push_back({ later.x2 + 1, y1, piece.x2, y2 });
+					}
+				}
+				pieces.swap(remaining);
+
+				if (pieces.empty()) { // Fully overwritten.
+					break;
+				}
+			}
+
+			disjoint.insert(disjoint.end(), pieces.begin(), pieces.end());
+		}
+
+		std::ranges::reverse(disjoint); // (Back to the batch order.)
+
+		return disjoint;
+	}
+
+
+	//	BasicFrameView class: A non-owning view of (a sub-rect of) the frame data, mdspan-like: pointer, extents, stride.
+	//
+	//	data_ --> +-------+-------+-------+
+	//	          | row 0 | row 0 | row 0 |	<-- The rows_ chars of a col are contiguous,
+	//	          | ...   | ...   | ...   |	    a col starts stride_ chars after the previous one
+	//	          +-------+-------+-------+	    (stride_ == rows_ for a whole frame, the frame rows for a sub-view).
+	//	            col 0   col 1   col 2
+	//
+	//	- Cheap to copy; valid as long as the viewed frame (buffer) is. FrameView: writable, ConstFrameView: read-only.
+	//	- The kernels get the view computed once per call (no per-col GetDataIndex() / GetRows()).
+
+	template<typename Char>
+	class BasicFrameView final
+	{
+	public:
+
+		BasicFrameView() = default;
+		BasicFrameView(Char* data, const size_t rows, const size_t cols) : BasicFrameView{ data, rows, cols, rows } {}
+		BasicFrameView(Char* data, const size_t rows, const size_t cols, const size_t stride) : data_{ data }, rows_{ rows }, cols_{ cols }, stride_{ stride } {}
+
+
+		// (FrameView -> ConstFrameView.)
+		template<typename Other> requires (std::is_same_v<Char, const Other>)
+		BasicFrameView(const BasicFrameView<Other>& other) : data_{ other.GetData() }, rows_{ other.GetRows() }, cols_{ other.GetCols() }, stride_{ other.GetStride() } {}
+
+
+		[[nodiscard]] Char* GetData() const { return data_; }
+		[[nodiscard]] size_t GetRows() const { return rows_; }
+		[[nodiscard]] size_t GetCols() const { return cols_; }
+		[[nodiscard]] size_t GetStride() const { return stride_; }
+		[[nodiscard]] bool IsEmpty() const { return data_ == nullptr; }
+
+
+		// Whether the cols follow each other with no gap (so all the chars are one contiguous span; see Span()).
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return rows_ == stride_ || cols_ <= 1;
+		}
+
+
+		// The char at row x, col y (unchecked).
+		[[nodiscard]] Char& At(const size_t x, const size_t y) const
+		{
+			return data_[x + y * stride_];
+		}
+
+
+		// The sub-view of rect (relative to this view; unchecked: rect must be within the view).
+		[[nodiscard]] BasicFrameView SubView(const FrameRect& rect) const
+		{
+			return { data_ + rect.x1 + rect.y1 * stride_, (rect.x2 - rect.x1) + 1, (rect.y2 - rect.y1) + 1, stride_ };
+		}
+
+
+		// The rows of col y (unchecked).
+		[[nodiscard]] std::span<Char> Col(const size_t y) const
+		{
+			return { data_ + y * stride_, rows_ };
+		}
+
+
+		// The cols, each as the std::span of its rows: for (std::span<char> col : view.Cols()) { ... }
+		[[nodiscard]] auto Cols() const
+		{
+			return std::views::iota(static_cast<size_t>(0), cols_) | std::views::transform([view = *this](const size_t y) { return view.Col(y); });
+		}
+
+
+		// All the chars, of a contiguous view only (see IsContiguous()).
+		[[nodiscard]] std::span<Char> Span() const
+		{
+			return { data_, cols_ == 0 ? 0 : (cols_ - 1) * stride_ + rows_ };
+		}
+
+	private:
+
+		Char* data_{ nullptr };
+		size_t rows_{ 0 }, cols_{ 0 }, stride_{ 0 };
+	};
+
+	using FrameView = BasicFrameView<char>;
+	using ConstFrameView = BasicFrameView<const char>;
+
+
+	//	Frame class: Represents a rectangular frame of characters.
+	//
+	//	buffer_ (Buffer)                                                 	<-- Pointer to memory allocated from a memory resource.
+	//	+-------------------------------+-------------------------------|   
+	//	|                               |                               |	<-- Rows (size_t). See: GetRows().
+	//	+-------------------------------+-------------------------------|
+	//	|                               |                               |	<-- Cols (size_t). See: GetCols().
+	//	+-------------------------------+-------------------------------|
+	//	| Pixel encoding (1 byte). See: GetEncoding().                  |
+	//	+-------------------------------+-------------------------------|
+	//	|                    (padding)                                  |
+	//	+-------------------------------+-------------------------------|
+	//	|       |       |       |       |       |       |       |       |	<-- Frame data (characters). See: GetDataIndex()
+	//	+-------+-------+-------+-------+-------+-------+-------+-------|
+	//	| ...   | ...   | ...   | ...   | ...   | ...   | ...   | ...   |
+	//	+-------+-------+-------+-------+-------+-------+-------+-------|
+	//
+	//	buffer_: Pointer to a memory block holding the frame data, allocated from a std::pmr::memory_resource
+	//	(new / delete by default; see PageResource) with the requested alignment.
+	//	- The first `sizeof(size_t)` bytes (typically 8 bytes on modern systems) store the number of rows.
+	//	- The next `sizeof(size_t)` bytes (typically 8 bytes on modern systems) store the number of columns.
+	//	- The next byte stores the pixel encoding (the "White" / "Black" chars).
+	//	- The header is padded to a cache line (kDataIndex), so the frame data keeps the buffer alignment (up to 64).
+	//	- The remaining memory stores the frame data, with each character occupying 1 byte.
+
+	class Frame final
+	{
+	public:
+
+		// Struct to define a rectangle within the frame:
+		using Rect = FrameRect;
+
+
+		// Count of chars per (unsigned) char value:
+		using CharHistogram = std::array<size_t, 256>;
+
+
+		using Buffer = std::unique_ptr<char[], BufferDeleter>;
+
+
+		// The chars of "White" (drawn) and "Black" (blank):
+		// kWhiteZero: "White" 0x00, "Black" 0xFF (the default).
+		// kBlackZero: "White" 0xFF, "Black" 0x00: a blank frame is zero pages (see Reset()).
+		enum class PixelEncoding : char { kWhiteZero = 0, kBlackZero = 1 };
+
+
+		static constexpr size_t kDefaultAlignment{ 64 }; // (Cache line.)
+		static constexpr size_t kDefaultStripeCols{ 64 }; // See: SetStripeCallback().
+		static constexpr size_t kDataIndex{ 64 }; // Buffer header: [rows][cols][encoding] + padding up to a cache line. See: GetDataIndex().
+		static constexpr size_t kEncodingIndex{ sizeof(size_t) * 2 };
+		static_assert(kDataIndex > kEncodingIndex);
+
+
+		// Constructor to create a frame with given dimensions:
+		// (resource: where the buffer is allocated from; alignment: a power of 2, of the buffer and of the frame data (up to 64).)
+		Frame(const size_t rows, const size_t cols, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), const size_t alignment = kDefaultAlignment,
+			const PixelEncoding encoding = PixelEncoding::kWhiteZero)
+		{
+			[[maybe_unused]] const auto create_ok{ Create(rows, cols, resource, alignment, encoding) };
+		}
+
+
+		// A frame moves between owners (pipeline stages) without copying or reallocating its buffer; it is not copyable.
+		// (A moved-from frame is empty, like a frame whose Create() failed.)
+		Frame(Frame&&) noexcept = default;
+		Frame& operator=(Frame&&) noexcept = default;
+		Frame(const Frame&) = delete;
+		Frame& operator=(const Frame&) = delete;
+
+
+		// Make a frame whose chars are initialized (to blank) lazily, per col: on the first partial draw of a col, or the
+		// first access to its chars (a view, statistics, ...). A draw covering whole cols never writes blank, and Reset()
+		// is O(cols). (Reads of a single char (GetPixel()) do not initialize.)
+		[[nodiscard]] static Frame Lazy(const size_t rows, const size_t cols, std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+			const size_t alignment = kDefaultAlignment, const PixelEncoding encoding = PixelEncoding::kWhiteZero)
+		{
+			Frame frame{ Buffer{} };
+			if (frame.Create(rows, cols, resource, alignment, encoding, true)) {
+				frame.initialized_cols_.assign(cols, 0);
+			}
+
+			return frame;
+		}
+
+
+		// Give up the buffer (rows and cols embedded; see Adopt()). The frame is left empty.
+		// (A lazy frame initializes its remaining cols first.)
+		[[nodiscard]] Buffer Release()
+		{
+			if (buffer_ != nullptr) {
+				InitializeCols(0, GetCols() - 1);
+			}
+			initialized_cols_.clear();
+			tracked_histogram_.reset();
+
+			return std::move(buffer_);
+		}
+
+
+		// Make a frame of a buffer given up by Release(), as is.
+		[[nodiscard]] static Frame Adopt(Buffer buffer)
+		{
+			Frame frame{ std::move(buffer) };
+			if (frame.buffer_ == nullptr || frame.GetRows() == 0 || frame.GetCols() == 0) {
+				std::cerr << "error: Adopt() not a frame buffer." << std::endl;
+
+				return Frame{ Buffer{} };
+			}
+
+			return frame;
+		}
+
+
+		// Make a frame of external memory (e.g. a device / shared buffer) of at least kDataIndex + rows * cols bytes
+		// (buffer.get_deleter().size). Its first kDataIndex bytes receive the header; the frame data is kept as is.
+		// (A BufferDeleter without a resource leaves the memory to its owner.)
+		[[nodiscard]] static Frame Adopt(Buffer buffer, const size_t rows, const size_t cols, const PixelEncoding encoding = PixelEncoding::kWhiteZero)
+		{
+			if (buffer == nullptr || !(rows > 0 && cols > 0) || buffer.get_deleter().size < kDataIndex + (rows * cols)) {
+				std::cerr << "error: Adopt() no buffer, rows and/or cols 0, or buffer too small." << std::endl;
+
+				return Frame{ Buffer{} };
+			}
+
+			// Embeds rows, cols and encoding into the buffer:
+			std::memcpy(buffer.get(), &rows, sizeof(size_t));
+			std::memcpy(buffer.get() + sizeof(size_t), &cols, sizeof(size_t));
+			buffer[kEncodingIndex] = static_cast<char>(encoding);
+
+			return Frame{ std::move(buffer) };
+		}
+
+
+		// A non-owning view of the frame data (empty if Create() failed). (A lazy frame initializes its remaining cols first.)
+		[[nodiscard]] FrameView View() const
+		{
+			if (buffer_ != nullptr) {
+				InitializeCols(0, GetCols() - 1);
+			}
+
+			return RawView();
+		}
+
+
+		// A non-owning read-only view of the frame data (empty if Create() failed). (As View().)
+		[[nodiscard]] ConstFrameView ConstView() const
+		{
+			return View();
+		}
+
+
+		// Draw "White" if frame with optimized_n worker-threads.
+		// The rect is clipped to the frame and to the clip region (see PushClip()) while preparing the segments: the
+		// segments split the visible cols only (the cols of the visible pieces, gaps between them skipped), and each
+		// thread draws the pieces within its segment.
+		// The cols are split by schedule (static segments by default, see SegmentSchedule).
+		bool Draw(const Rect& rect, const size_t n = 1, const SegmentSchedule schedule = SegmentSchedule::kStatic) const
+		{
+			const bool feasible{ DrawClipChecks(rect) };
+			const std::vector<Rect> pieces{ feasible ? ClipRect(rect) : std::vector<Rect>{} }; // (Disjoint.)
+
+			size_t x_min{ std::numeric_limits<size_t>::max() }, x_max{ 0 }, visible_chars{ 0 };
+			std::vector<std::pair<size_t, size_t>> col_spans; // The visible cols: the col spans of the pieces, sorted and merged.
+			for (const Rect& piece : pieces) {
+				x_min = std::min(x_min, piece.x1);
+				x_max = std::max(x_max, piece.x2);
+				visible_chars += (piece.x2 - piece.x1 + 1) * (piece.y2 - piece.y1 + 1);
+				col_spans.emplace_back(piece.y1, piece.y2);
+			}
+			std::ranges::sort(col_spans);
+			std::vector<size_t> span_offsets; // (The first visible col of each span, counted over the visible cols.)
+			size_t cols_to_draw{ 0 };
+			for (size_t i = 0, merged = 0; i < col_spans.size(); ++i) {
+				if (merged > 0 && col_spans[i].first <= col_spans[merged - 1].second + 1) {
+					col_spans[merged - 1].second = std::max(col_spans[merged - 1].second, col_spans[i].second);
+				}
+				else {
+					col_spans[merged++] = col_spans[i];
+				}
+				if (i + 1 == col_spans.size()) {
+					col_spans.resize(merged);
+				}
+			}
+			for (const auto& span : col_spans) {
+				span_offsets.push_back(cols_to_draw);
+				cols_to_draw += span.second - span.first + 1;
+			}
+
+			const size_t optimized_n{ OptimizeThreadCount(n, cols_to_draw) };
+
+			std::string note{ "main-thread" };
+			if (optimized_n > 1) {
+				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
+				if (schedule != SegmentSchedule::kStatic) {
+					note += ", " + std::string{ GetScheduleName(schedule) } + " schedule";
+				}
+			}
+
+			const uint64_t rect_chars{ feasible ? GetRectChars(rect) : 0 };
+			const auto chars{ FormatCharCount(rect_chars) };
+			std::cout << "draw (" << note << ") (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << chars << " chars"
+				<< (feasible && visible_chars < rect_chars ? ", clipped to: " + FormatCharCount(visible_chars) + " chars" : "") << ")" << std::endl;
+
+			if (!feasible) {
+				std::cerr << "error: Draw() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			if (pieces.empty()) { // Clipped out: nothing to draw.
+				return true;
+			}
+
+			const auto start_time = Now(); // <-- Start.
+
+			const FrameView view{ RawView() };
+			const char white{ GetWhite() };
+			const size_t rows{ GetRows() };
+
+			// Call function(from, to) for each (frame) col span of the visible cols segment.first - segment.second:
+			const auto for_each_cols = [&](const std::pair<size_t, size_t> segment, const auto& function) {
+				size_t span{ static_cast<size_t>(std::ranges::upper_bound(span_offsets, segment.first) - span_offsets.begin()) - 1 };
+				for (; span < col_spans.size() && span_offsets[span] <= segment.second; ++span) {
+					const size_t first{ std::max(segment.first, span_offsets[span]) - span_offsets[span] };
+					const size_t last{ std::min(segment.second - span_offsets[span], col_spans[span].second - col_spans[span].first) };
+					function(col_spans[span].first + first, col_spans[span].first + last);
+				}
+			};
+
+			// Draw the pieces within the cols from - to, into overwritten (optional) per piece:
+			const auto draw_cols = [&](const size_t from, const size_t to, CharHistogram* overwritten) {
+				for (const Rect& piece : pieces) {
+					if (piece.y2 < from || piece.y1 > to) {
+						continue; // (Not in this segment.)
+					}
+
+					// (A lazy frame: whole cols drawn need no blank first, unless what is overwritten is counted.)
+					const bool whole_cols{ piece.x1 == 0 && piece.x2 == rows - 1 && overwritten == nullptr };
+					InitializeCols(std::max(piece.y1, from), std::min(piece.y2, to), whole_cols);
+
+					const std::pair<size_t, size_t> piece_segment{ std::max(piece.y1, from) - piece.y1, std::min(piece.y2, to) - piece.y1 };
+					if (overwritten == nullptr) {
+						DrawThread(view.SubView(piece), piece_segment, white);
+					}
+					else {
+						CharHistogram piece_overwritten{};
+						DrawThread(view.SubView(piece), piece_segment, white, &piece_overwritten);
+						for (size_t v = 0; v < overwritten->size(); ++v) {
+							(*overwritten)[v] += piece_overwritten[v];
+						}
+					}
+				}
+			};
+
+			// Draw the segment (of the visible cols), publishing each stripe (of stripe_cols_ visible cols; a stripe over a
+			// gap is published per col span) once drawn (see SetStripeCallback()):
+			const auto draw_stripes = [&](const std::pair<size_t, size_t> segment, CharHistogram* overwritten) {
+				if (!stripe_callback_) {
+					for_each_cols(segment, [&](const size_t from, const size_t to) { draw_cols(from, to, overwritten); });
+					return;
+				}
+
+				for (size_t from = segment.first; from <= segment.second; from += stripe_cols_) {
+					for_each_cols({ from, std::min(from + stripe_cols_ - 1, segment.second) }, [&](const size_t from_col, const size_t to_col) {
+						draw_cols(from_col, to_col, overwritten);
+						stripe_callback_({ x_min, from_col, x_max, to_col });
+					});
+				}
+			};
+
+			if (tracked_histogram_ == nullptr) {
+				RunChunks(cols_to_draw, optimized_n, schedule, [&](size_t, const std::pair<size_t, size_t> segment) { draw_stripes(segment, nullptr); });
+			}
+			else { // Also collect what is overwritten (per thread), to update the tracked histogram:
+				std::vector<CharHistogram> overwritten(optimized_n);
+				RunChunks(cols_to_draw, optimized_n, schedule, [&](const size_t i, const std::pair<size_t, size_t> segment) { draw_stripes(segment, &overwritten[i]); });
+
+				for (const auto& histogram : overwritten) {
+					for (size_t v = 0; v < histogram.size(); ++v) {
+						(*tracked_histogram_)[v] -= histogram[v];
+					}
+				}
+				(*tracked_histogram_)[static_cast<unsigned char>(white)] += visible_chars; // Drawn "White".
+			}
+
+			PrintDuration(start_time); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Push a clip region: the union of rects (may overlap), within the current clip region.
+		// Draw() draws only inside the clip region (plans, queues and views draw as given).
+		bool PushClip(const std::span<const Rect> rects)
+		{
+			if (std::ranges::any_of(rects, [](const Rect& rect) { return rect.x2 < rect.x1 || rect.y2 < rect.y1; })) {
+				std::cerr << "error: PushClip() x1-y1 is beyond x2-y2." << std::endl;
+
+				return false;
+			}
+
+			std::vector<Rect> region;
+			for (const Rect& clip : SubtractRects(rects)) { // (Disjoint: each char is drawn once.)
+				if (clip_stack_.empty()) {
+					region.push_back(clip);
+					continue;
+				}
+
+				for (const Rect& current : clip_stack_.back()) {
+					Rect intersection{};
+					if (IntersectRects(clip, current, intersection)) {
+						region.push_back(intersection);
+					}
+				}
+			}
+
+			clip_stack_.push_back(std::move(region));
+
+			return true;
+		}
+
+
+		// Push a clip rect, within the current clip region.
+		bool PushClip(const Rect& rect)
+		{
+			return PushClip(std::span<const Rect>{ &rect, 1 });
+		}
+
+
+		// Pop the last clip region (restoring the previous one).
+		bool PopClip()
+		{
+			if (clip_stack_.empty()) {
+				std::cerr << "error: PopClip() clip stack is empty." << std::endl;
+
+				return false;
+			}
+
+			clip_stack_.pop_back();
+
+			return true;
+		}
+
+
+		[[nodiscard]] size_t GetClipDepth() const { return clip_stack_.size(); }
+
+
+		// Draw "White" in a view (e.g. a sub-view of a frame handed to a subsystem) with optimized_n worker-threads.
+		// (Not reflected in a tracked histogram: the view does not know its frame. white: see GetWhite().)
+		static bool DrawView(const FrameView& view, const size_t n = 1, const char white = 0x00)
+		{
+			if (view.IsEmpty() || view.GetRows() == 0 || view.GetCols() == 0) {
+				std::cerr << "error: DrawView() empty view." << std::endl;
+
+				return false;
+			}
+
+			const size_t optimized_n{ OptimizeThreadCount(n, view.GetCols()) };
+
+			std::string note{ "main-thread" };
+			if (optimized_n > 1) {
+				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
+			}
+
+			std::cout << "draw view (" << note << ") (rows: " << view.GetRows() << ", cols: " << view.GetCols() << ", total: " << FormatCharCount(view.GetRows() * view.GetCols()) << " chars)" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			RunSegments(view.GetCols(), optimized_n, [&](size_t, const std::pair<size_t, size_t> segment) { DrawThread(view, segment, white); });
+
+			PrintDuration(start_time); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Print the frame.
+		// This is mainly for debug / demo.
+		// Usefull on small frame (~ up to 100 rows).
+		[[nodiscard]] bool PrintFrame() const
+		{
+			if (buffer_ == nullptr) { // Create() failed.
+				std::cerr << "error: PrintFrame() frame buffer is nullptr." << std::endl;
+
+				return false;
+			}
+
+			InitializeCols(0, GetCols() - 1);
+
+			size_t start_p{ GetDataIndex() };
+			const char white{ GetWhite() };
+
+			std::cout << "frame" << std::endl;
+			for (size_t i = 0; i < GetCols(); ++i) {
+				std::span<char> char_span(&buffer_.get()[start_p], GetRows());
+				std::ranges::for_each(char_span, [white](char c) { std::cout << ((c == white) ? '0' : '1'); }); std::cout << std::endl;
+				start_p += GetRows();
+			}
+
+			return true;
+		}
+
+		// Convolve the frame into dst with a separable kernel (along the rows, then across the cols) with optimized_n worker-threads.
+		// kernel: odd number of non-negative weights (normalized here). dst: a different frame of the same dimensions.
+		bool Convolve(Frame& dst, std::span<const float> kernel, const size_t n = 1) const
+		{
+			if (!ConvolveSanityChecks(dst, kernel)) {
+				std::cerr << "error: Convolve() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const size_t cols{ GetCols() };
+
+			const size_t optimized_n{ OptimizeThreadCount(n, cols) };
+
+			std::string note{ "main-thread" };
+			if (optimized_n > 1) {
+				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
+			}
+
+			const auto chars{ FormatCharCount(GetRows() * cols) };
+			std::cout << "convolve (" << note << ") (kernel: " << kernel.size() << " taps, total: " << chars << " chars)" << std::endl;
+
+			// Normalize the kernel, so a uniform area keeps its value:
+			const float sum{ std::accumulate(kernel.begin(), kernel.end(), 0.0f) };
+			std::vector<float> weights(kernel.size());
+			std::ranges::transform(kernel, weights.begin(), [sum](const float w) { return w / sum; });
+
+			const auto start_time = Now(); // <-- Start.
+
+			const ConstFrameView src_view{ ConstView() };
+			const FrameView dst_view{ dst.View() };
+
+			RunSegments(cols, optimized_n, [&](size_t, const std::pair<size_t, size_t> segment) { ConvolveThread(src_view, dst_view, weights, segment); });
+
+			PrintDuration(start_time); // <-- Finish.
+
+			// dst was rewritten as a whole; recount its tracked histogram (if any):
+			if (dst.tracked_histogram_ != nullptr) {
+				dst.CountHistogram({ 0, 0, dst.GetRows() - 1, dst.GetCols() - 1 }, *dst.tracked_histogram_, optimized_n);
+			}
+
+			return true;
+		}
+
+
+		// Build a (not normalized) gaussian kernel of 2 * radius + 1 taps for Convolve().
+		[[nodiscard]] static std::vector<float> GaussianKernel(const size_t radius, const float sigma)
+		{
+			std::vector<float> kernel(2 * radius + 1);
+			for (size_t i = 0; i < kernel.size(); ++i) {
+				const float d{ static_cast<float>(i) - static_cast<float>(radius) };
+				kernel[i] = std::exp(-(d * d) / (2.0f * sigma * sigma));
+			}
+
+			return kernel;
+		}
+
+
+		// Compute the histogram of the chars within rect with optimized_n worker-threads.
+		bool ComputeHistogram(const Rect& rect, CharHistogram& histogram, const size_t n = 1) const
+		{
+			if (!DrawSanityChecks(rect)) { // (Same rect constraints as Draw().)
+				std::cerr << "error: ComputeHistogram() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const size_t chars{ (rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1) };
+			std::cout << "histogram (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << FormatCharCount(chars) << " chars)" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			CountHistogram(rect, histogram, OptimizeThreadCount(n, (rect.y2 - rect.y1) + 1));
+
+			PrintBandwidth(start_time, chars); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Compute the coverage (share of "White" chars, 0.0 - 1.0) within rect with optimized_n worker-threads.
+		bool ComputeCoverage(const Rect& rect, double& coverage, const size_t n = 1) const
+		{
+			if (!DrawSanityChecks(rect)) { // (Same rect constraints as Draw().)
+				std::cerr << "error: ComputeCoverage() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const size_t cols_to_count{ (rect.y2 - rect.y1) + 1 };
+			const size_t chars{ (rect.x2 - rect.x1 + 1) * cols_to_count };
+			std::cout << "coverage (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << FormatCharCount(chars) << " chars)" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			const size_t optimized_n{ OptimizeThreadCount(n, cols_to_count) };
+			std::vector<size_t> white(optimized_n); // Per thread (so we don't need thread syncronization).
+
+			InitializeCols(rect.y1, rect.y2);
+			const ConstFrameView view{ RawView().SubView(rect) };
+			const char white_char{ GetWhite() };
+			RunSegments(cols_to_count, optimized_n, [&](const size_t i, const std::pair<size_t, size_t> segment) {
+				for (size_t col = segment.first; col <= segment.second; ++col) {
+					white[i] += CountValue(view.Col(col), white_char);
+				}
+			});
+
+			coverage = static_cast<double>(std::accumulate(white.begin(), white.end(), static_cast<size_t>(0))) / chars;
+
+			PrintBandwidth(start_time, chars); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Count the histogram of the whole frame (with optimized_n worker-threads), and keep it up to date on every Draw(),
+		// from the chars each draw overwrites (so it costs O(rect), not O(frame)). See: GetTrackedHistogram().
+		bool TrackHistogram(const size_t n = 1)
+		{
+			if (buffer_ == nullptr) { // Create() failed.
+				std::cerr << "error: TrackHistogram() frame buffer is nullptr." << std::endl;
+
+				return false;
+			}
+
+			tracked_histogram_ = std::make_unique<CharHistogram>();
+			CountHistogram({ 0, 0, GetRows() - 1, GetCols() - 1 }, *tracked_histogram_, OptimizeThreadCount(n, GetCols()));
+
+			return true;
+		}
+
+
+		// Return the tracked histogram (nullptr if TrackHistogram() was not called).
+		[[nodiscard]] const CharHistogram* GetTrackedHistogram() const
+		{
+			return tracked_histogram_.get();
+		}
+
+
+		// Called by Draw() for each stripe (up to stripe_cols cols of the drawn rect) as soon as it is drawn, so the next
+		// stage (e.g. an encoder) can read it while the other stripes are still being drawn. Its rows are the bounds of
+		// the visible pieces (see PushClip()).
+		// The callback runs on the drawing threads, concurrently: the stripe's chars are final when it is called, and
+		// visible to the thread it hands the stripe to (e.g. through a BoundedQueue). An empty callback: no stripes.
+		using StripeCallback = std::function<void(const Rect& stripe)>;
+
+		void SetStripeCallback(StripeCallback callback, const size_t stripe_cols = kDefaultStripeCols)
+		{
+			stripe_callback_ = std::move(callback);
+			stripe_cols_ = std::max(stripe_cols, static_cast<size_t>(1));
+		}
+
+
+		// Reset the frame to blank ("Black") with optimized_n worker-threads.
+		// discard: a kBlackZero frame allocated from a PageResource gives its pages back to the OS instead (they come
+		// back as zero pages, on the next touch: O(pages) to unmap, instead of writing every char).
+		bool Reset(const size_t n = 1, const bool discard = true) const
+		{
+			if (buffer_ == nullptr) { // Create() failed.
+				std::cerr << "error: Reset() frame buffer is nullptr." << std::endl;
+
+				return false;
+			}
+
+			const size_t rows{ GetRows() }, cols{ GetCols() };
+			const char black{ GetBlack() };
+
+			if (!initialized_cols_.empty()) { // A lazy frame: blank on the next access.
+				std::ranges::fill(initialized_cols_, 0);
+			}
+
+			const auto* page_resource{ dynamic_cast<const PageResource*>(buffer_.get_deleter().resource) };
+			const bool discarded{ discard && black == 0x00 && page_resource != nullptr && page_resource->Discard(buffer_.get() + GetDataIndex(), rows * cols) };
+
+			if (!discarded && initialized_cols_.empty()) {
+				const FrameView view{ View() };
+				RunSegments(cols, OptimizeThreadCount(n, cols), [&](size_t, const std::pair<size_t, size_t> segment) {
+					// (A segment of whole cols is contiguous in the buffer.)
+					std::ranges::fill(view.SubView({ 0, segment.first, rows - 1, segment.second }).Span(), black); // Draw "Black".
+				});
+			}
+
+			if (tracked_histogram_ != nullptr) {
+				*tracked_histogram_ = {};
+				(*tracked_histogram_)[static_cast<unsigned char>(black)] = rows * cols;
+			}
+
+			return true;
+		}
+
+
+		// The pixel encoding (kWhiteZero if Create() failed).
+		[[nodiscard]] PixelEncoding GetEncoding() const
+		{
+			return buffer_ == nullptr ? PixelEncoding::kWhiteZero : static_cast<PixelEncoding>(buffer_[kEncodingIndex]);
+		}
+
+
+		// The char of "White" (drawn) / "Black" (blank), by the pixel encoding.
+		[[nodiscard]] char GetWhite() const { return GetEncoding() == PixelEncoding::kBlackZero ? static_cast<char>(0xFF) : 0x00; }
+		[[nodiscard]] char GetBlack() const { return GetEncoding() == PixelEncoding::kBlackZero ? 0x00 : static_cast<char>(0xFF); }
+
+
+		// Get the char at row x, col y.
+		// This is mainly for debug / test (0x00 if out of the frame).
+		[[nodiscard]] char GetPixel(const size_t x, const size_t y) const
+		{
+			if (buffer_ == nullptr || x >= GetRows() || y >= GetCols()) {
+				std::cerr << "error: GetPixel() out of the frame." << std::endl;
+
+				return 0x00;
+			}
+
+			if (!initialized_cols_.empty() && initialized_cols_[y] == 0) { // (A lazy frame: blank, not initialized yet.)
+				return GetBlack();
+			}
+
+			return buffer_[GetDataIndex() + x + y * GetRows()];
+		}
+
+	protected:
+
+		friend class FramePool; // (Recycles buffer_.)
+		friend class DrawPlan; // (Validates with DrawSanityChecks().)
+		friend class DrawQueue; // (Validates with DrawSanityChecks().)
+
+
+		// Constructor to wrap a buffer of an earlier frame (rows and cols embedded), as is:
+		explicit Frame(Buffer buffer) : buffer_{ std::move(buffer) } {}
+
+
+		// Rows per cache block of ConvolveThread(): the 2r+1 filtered cols of a block (+ accumulators) stay in L2.
+		static constexpr size_t kConvolveBlockRows{ 2048 };
+
+
+		// Check that Draw() is feasible, for a rect clipped to the frame (see ClipRect()).
+		[[nodiscard]] bool DrawClipChecks(const Rect& rect) const
+		{
+			return (!(rect.x2 < rect.x1 || rect.y2 < rect.y1 // x1-y1 is beyond x2-y2.
+				|| buffer_ == nullptr)); // Create() failed.
+		}
+
+
+		// The visible (disjoint) pieces of rect: within the frame, and within the clip region (if any).
+		[[nodiscard]] std::vector<Rect> ClipRect(const Rect& rect) const
+		{
+			std::vector<Rect> pieces;
+
+			Rect visible{};
+			if (!IntersectRects(rect, { 0, 0, GetRows() - 1, GetCols() - 1 }, visible)) {
+				return pieces;
+			}
+
+			if (clip_stack_.empty()) {
+				pieces.push_back(visible);
+			}
+			else {
+				for (const Rect& clip : clip_stack_.back()) {
+					Rect piece{};
+					if (IntersectRects(visible, clip, piece)) {
+						pieces.push_back(piece);
+					}
+				}
+			}
+
+			return pieces;
+		}
+
+
+		// Check that a rect is within the frame (plans, queues, statistics).
+		[[nodiscard]] bool DrawSanityChecks(const Rect& rect) const
+		{
+			return (!(rect.x1 < 0 || rect.y1 < 0 // x1-y1 negative.
+				|| rect.x2 < rect.x1 || rect.y2 < rect.y1 // x1-y1 is beyond x2-y2.
+				|| rect.x2 > GetRows() - 1 || rect.y2 > GetCols() - 1 // x2-y2 is exceeds frame.
+				|| buffer_ == nullptr)); // Create() failed.
+		}
+
+
+		// (Run in the context of multiple threads; no syncronization! - SEGMENTS SHOULD NOT OVERLAP!)
+		// Draw segment. 
+		// segment is col from - to offsets (*relative to the view*, e.g. the sub-view of the drawn rect).
+		// white: the "White" char (see GetWhite()).
+		// overwritten (optional): receives the histogram of the chars this segment overwrites.
+		static void DrawThread(const FrameView& view, std::pair<size_t, size_t> segment, const char white, CharHistogram* overwritten = nullptr)
+		{
+			// (Each thread writes to an exclusive segments of the buffer => No need for mutex.)
+			const FrameView segment_view{ view.SubView({ 0, segment.first, view.GetRows() - 1, segment.second }) };
+			const auto for_each_span = [&](const auto& draw_span) {
+				if (segment_view.IsContiguous()) { // Whole cols: a single span.
+					draw_span(segment_view.Span());
+				}
+				else {
+					for (std::span<char> col : segment_view.Cols()) {
+						draw_span(col);
+					}
+				}
+			};
+
+			if (overwritten == nullptr) { // Draw "White" only (the hot path: no tables to clear).
+				for_each_span([&](const std::span<char> char_span) { std::ranges::fill(char_span, white); });
+
+				return;
+			}
+
+			// Draw "White", counting what is overwritten:
+			CharTables tables{};
+			for_each_span([&](const std::span<char> char_span) {
+				CountChars(char_span, tables);
+				std::ranges::fill(char_span, white);
+			});
+			*overwritten = MergeTables(tables);
+		}
+
+
+		// Statistics__
+
+		// Interleaved histograms: consecutive chars are counted into different tables, so runs of the same char
+		// don't stall on incrementing the same counter.
+		using CharTables = std::array<CharHistogram, 4>;
+
+
+		// Count the chars into tables.
+		static void CountChars(std::span<const char> chars, CharTables& tables)
+		{
+			size_t i{ 0 };
+			for (; i + 4 <= chars.size(); i += 4) {
+				++tables[0][static_cast<unsigned char>(chars[i])];
+				++tables[1][static_cast<unsigned char>(chars[i + 1])];
+				++tables[2][static_cast<unsigned char>(chars[i + 2])];
+				++tables[3][static_cast<unsigned char>(chars[i + 3])];
+			}
+			for (; i < chars.size(); ++i) {
+				++tables[0][static_cast<unsigned char>(chars[i])];
+			}
+		}
+
+
+		// Sum the interleaved tables into one histogram.
+		[[nodiscard]] static CharHistogram MergeTables(const CharTables& tables)
+		{
+			CharHistogram histogram{};
+			for (const auto& table : tables) {
+				for (size_t v = 0; v < histogram.size(); ++v) {
+					histogram[v] += table[v];
+				}
+			}
+
+			return histogram;
+		}
+
+
+		// Count the chars equal to value (SWAR compare + popcount): each 8 chars word yields one (high) bit per match,
+		// the bits of 8 words are shifted into one word, then counted with a single popcount per 64 chars.
+		[[nodiscard]] static size_t CountValue(std::span<const char> chars, const char value)
+		{
+			constexpr uint64_t kLow7{ 0x7F7F7F7F7F7F7F7FULL };
+			const uint64_t pattern{ 0x0101010101010101ULL * static_cast<unsigned char>(value) };
+
+			// High bit of each char set <=> char equal to value (other bits clear):
+			const auto match_bits = [&](const char* p) {
+				uint64_t word{ 0 };
+				std::memcpy(&word, p, sizeof(uint64_t));
+				word ^= pattern; // Chars equal to value -> 0x00.
+
+				const uint64_t non_zero{ ((word & kLow7) + kLow7) | word }; // High bit of each char set <=> char non-zero.
+				return ~(non_zero | kLow7);
+			};
+
+			size_t count{ 0 }, i{ 0 };
+			for (; i + 8 * sizeof(uint64_t) <= chars.size(); i += 8 * sizeof(uint64_t)) {
+				uint64_t bits{ 0 };
+				for (size_t j = 0; j < 8; ++j) {
+					bits |= match_bits(chars.data() + i + j * sizeof(uint64_t)) >> j; // (Disjoint bit positions.)
+				}
+				count += std::popcount(bits);
+			}
+			for (; i + sizeof(uint64_t) <= chars.size(); i += sizeof(uint64_t)) {
+				count += std::popcount(match_bits(chars.data() + i));
+			}
+			for (; i < chars.size(); ++i) {
+				count += (chars[i] == value) ? 1 : 0;
+			}
+
+			return count;
+		}
+
+
+		// Count the histogram of the chars within rect (pre-checked) with optimized_n threads.
+		void CountHistogram(const Rect& rect, CharHistogram& histogram, const size_t optimized_n) const
+		{
+			std::vector<CharHistogram> partial(optimized_n); // Per thread (so we don't need thread syncronization).
+
+			InitializeCols(rect.y1, rect.y2);
+			const ConstFrameView view{ RawView().SubView(rect) };
+			RunSegments((rect.y2 - rect.y1) + 1, optimized_n, [&](const size_t i, const std::pair<size_t, size_t> segment) {
+				CharTables tables{};
+				for (size_t col = segment.first; col <= segment.second; ++col) {
+					CountChars(view.Col(col), tables);
+				}
+				partial[i] = MergeTables(tables);
+			});
+
+			histogram = {};
+			for (const auto& counts : partial) {
+				for (size_t v = 0; v < histogram.size(); ++v) {
+					histogram[v] += counts[v];
+				}
+			}
+		}
+
+
+		// __Statistics
+
+
+		// Check that Convolve() is feasible.
+		[[nodiscard]] bool ConvolveSanityChecks(const Frame& dst, std::span<const float> kernel) const
+		{
+			return (!(buffer_ == nullptr || dst.buffer_ == nullptr // Create() failed.
+				|| dst.buffer_ == buffer_ // Convolve() does not work in place.
+				|| dst.GetRows() != GetRows() || dst.GetCols() != GetCols() // Dimensions mismatch.
+				|| kernel.size() % 2 == 0 // Even number of taps (no center).
+				|| std::ranges::any_of(kernel, [](const float w) { return w < 0.0f; }) // Negative weight.
+				|| std::accumulate(kernel.begin(), kernel.end(), 0.0f) <= 0.0f)); // Nothing to normalize by.
+		}
+
+
+		// (Run in the context of multiple threads; no syncronization! - SEGMENTS SHOULD NOT OVERLAP!)
+		// Convolve segment. 
+		// segment is dst col from - to offsets. Only the segment cols of dst are written; the source cols within
+		// the kernel radius around the segment (the "halo") are only read, so neighbouring segments may share them.
+		static void ConvolveThread(const ConstFrameView& src, const FrameView& dst, std::span<const float> weights, const std::pair<size_t, size_t> segment)
+		{
+			const size_t rows{ src.GetRows() }, cols{ src.GetCols() };
+			const size_t taps{ weights.size() }, radius{ taps / 2 };
+
+			std::vector<float> padded_buffer(kConvolveBlockRows + 2 * radius);
+			std::vector<float> ring_buffer(taps * kConvolveBlockRows); // Row-filtered (and rounded) cols (c - radius) - (c + radius) of the block.
+			std::vector<const float*> sources(taps); // The input of each tap (see ConvolveRows()).
+
+			float* const padded{ padded_buffer.data() };
+			float* const ring{ ring_buffer.data() };
+
+			// Process the rows in cache blocks; within a block slide across the cols (halo included):
+			for (size_t x0 = 0; x0 < rows; x0 += kConvolveBlockRows) {
+				const size_t len{ std::min(kConvolveBlockRows, rows - x0) };
+
+				for (size_t k = 0; k <= (segment.second - segment.first) + 2 * radius; ++k) {
+
+					// Pass 1: filter source col (segment.first + k - radius), clamped to the frame, along the rows into the ring:
+					const size_t shifted_col{ segment.first + k }; // (+ radius, so it stays unsigned)
+					const size_t src_col{ shifted_col < radius ? 0 : std::min(shifted_col - radius, cols - 1) };
+					const char* src_p{ src.Col(src_col).data() };
+
+					// (Rows beyond the frame edges are clamped; the inner part is a plain contiguous copy.)
+					const size_t lead{ x0 < radius ? radius - x0 : 0 }, // Padding rows before row 0.
+						inner{ std::min(len + 2 * radius - lead, rows - (x0 + lead - radius)) }; // Rows inside the frame.
+					const unsigned char* __restrict const in_p{ reinterpret_cast<const unsigned char*>(src_p) + (x0 + lead - radius) };
+					float* __restrict const padded_inner{ padded + lead }; // (A char source may alias any store, unless __restrict.)
+					std::fill_n(padded, lead, static_cast<float>(static_cast<unsigned char>(src_p[0])));
+					for (size_t i = 0; i < inner; ++i) {
+						padded_inner[i] = in_p[i];
+					}
+					std::fill(padded + lead + inner, padded + len + 2 * radius, static_cast<float>(static_cast<unsigned char>(src_p[rows - 1])));
+
+					for (size_t t = 0; t < taps; ++t) {
+						sources[t] = padded + t;
+					}
+					ConvolveRows(sources, weights, len, ring + (k % taps) * kConvolveBlockRows); // (Kept as float so pass 2 is SIMD too; rounded like a stored char.)
+
+					if (k < 2 * radius) { // Ring not full yet.
+						continue;
+					}
+
+					// Pass 2: filter across the ring (cols (c - radius) - (c + radius)) into dst col c:
+					for (size_t t = 0; t < taps; ++t) {
+						sources[t] = ring + ((k - 2 * radius + t) % taps) * kConvolveBlockRows;
+					}
+
+					// (Each thread writes to an exclusive segments of the buffer => No need for mutex.)
+					ConvolveRows(sources, weights, len, dst.Col(segment.first + k - 2 * radius).data() + x0);
+				}
+			}
+		}
+
+
+		// out[i] = the weighted sum of sources[t][i] over the taps t, rounded like a stored char, for rows i 0 - (len - 1)
+		// (float or char out; normalized weights => never above 255).
+		// SSE2 where available (x64): 8 rows per iteration, their sums kept in registers across the taps (no store /
+		// reload of an accumulator per tap), packed straight to chars for char out. The sums are in the same order as
+		// the scalar loop (the tail, and other targets), so the results are identical.
+		template<typename Out>
+		static void ConvolveRows(const std::span<const float* const> sources, const std::span<const float> weights, const size_t len, Out* const out)
+		{
+			const size_t taps{ weights.size() };
+			size_t i{ 0 };
+
+#if defined(_M_X64) || defined(__SSE2__)
+			const __m128 half{ _mm_set1_ps(0.5f) };
+			for (; i + 8 <= len; i += 8) {
+				__m128 low{ _mm_setzero_ps() }, high{ _mm_setzero_ps() };
+				for (size_t t = 0; t < taps; ++t) {
+					const __m128 w{ _mm_set1_ps(weights[t]) };
+					low = _mm_add_ps(low, _mm_mul_ps(w, _mm_loadu_ps(sources[t] + i)));
+					high = _mm_add_ps(high, _mm_mul_ps(w, _mm_loadu_ps(sources[t] + i + 4)));
+				}
+
+				const __m128i low_rounded{ _mm_cvttps_epi32(_mm_add_ps(low, half)) }, high_rounded{ _mm_cvttps_epi32(_mm_add_ps(high, half)) };
+				if constexpr (std::is_same_v<Out, float>) {
+					_mm_storeu_ps(out + i, _mm_cvtepi32_ps(low_rounded));
+					_mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(high_rounded));
+				}
+				else { // (32 -> 16 -> 8 bits: 0 - 255, no saturation.)
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_packs_epi32(low_rounded, high_rounded), _mm_setzero_si128()));
+				}
+			}
+#endif
+
+			for (; i < len; ++i) {
+				float sum{ 0.0f };
+				for (size_t t = 0; t < taps; ++t) {
+					sum += weights[t] * sources[t][i];
+				}
+				out[i] = static_cast<Out>(static_cast<int>(sum + 0.5f));
+			}
+		}
+
+
+		// Create a blank frame (lazy: the frame data is left uninitialized; see Lazy()).
+		[[nodiscard]] bool Create(const size_t rows, const size_t cols, std::pmr::memory_resource* resource, const size_t alignment, const PixelEncoding encoding,
+			const bool lazy = false)
+		{
+			// If rows and/or cols 0, return false. buffer_ stays nullptr.
+			if (!(rows > 0 && cols > 0)) {
+				std::cerr << "error: Create() rows and/or cols 0." << std::endl;
+
+				return false;
+			}
+
+			if (resource == nullptr || !std::has_single_bit(alignment)) {
+				std::cerr << "error: Create() no memory resource, or alignment not a power of 2." << std::endl;
+
+				return false;
+			}
+
+			try
+			{
+				const size_t buffer_size{ GetDataIndex() + (cols * rows) };
+				buffer_ = Buffer(static_cast<char*>(resource->allocate(buffer_size, alignment)), BufferDeleter{ resource, buffer_size, alignment });
+
+				// Embeds rows, cols and encoding into buffer_:
+				std::memcpy(buffer_.get(), &rows, sizeof(size_t));
+				std::memcpy(buffer_.get() + sizeof(size_t), &cols, sizeof(size_t));
+				buffer_[kEncodingIndex] = static_cast<char>(encoding);
+
+				// Initialize empty frame (fresh pages from a PageResource are zero already):
+				if (!lazy && (GetBlack() != 0x00 || dynamic_cast<PageResource*>(resource) == nullptr)) {
+					std::memset(buffer_.get() + GetDataIndex(), GetBlack(), cols * rows); // Draw "Black".
+				}
+
+				std::cout << "create frame (rows: " << rows << ", cols: " << cols << (lazy ? ", lazy" : "") << ")" << std::endl;
+			}
+			catch ([[maybe_unused]] const std::bad_alloc& e)
+			{
+				// buffer_ stays nullptr.
+				return false;
+			}
+
+			return true;
+		}
+
+
+		// A view of the frame data as is (a lazy frame: including the cols not initialized yet).
+		[[nodiscard]] FrameView RawView() const
+		{
+			return buffer_ == nullptr ? FrameView{} : FrameView{ buffer_.get() + GetDataIndex(), GetRows(), GetCols() };
+		}
+
+
+		// (Run in the context of multiple threads for disjoint cols.)
+		// A lazy frame: initialize (to blank) cols y1 - y2 not initialized yet; whole_cols: they are about to be overwritten
+		// whole, mark them only.
+		void InitializeCols(const size_t y1, const size_t y2, const bool whole_cols = false) const
+		{
+			if (initialized_cols_.empty()) { // (Not lazy.)
+				return;
+			}
+
+			const FrameView view{ RawView() };
+			for (size_t y = y1; y <= y2; ++y) {
+				if (initialized_cols_[y] == 0) {
+					if (!whole_cols) {
+						std::ranges::fill(view.Col(y), GetBlack()); // Draw "Black".
+					}
+					initialized_cols_[y] = 1;
+				}
+			}
+		}
+
+
+		// Buffer indicators__
+
+		// Extract rows from the buffer.
+		[[nodiscard]] size_t GetRows() const
+		{
+			if (buffer_ == nullptr) { // Create() failed.
+				std::cerr << "error: GetRows() frame buffer is nullptr." << std::endl;
+
+				return 0;
+			}
+
+			size_t rows{ 0 };
+			std::memcpy(&rows, buffer_.get(), sizeof(size_t));
+
+			return rows;
+		}
+
+
+		// Extract cols from the buffer .
+		[[nodiscard]] size_t GetCols() const
+		{
+			if (buffer_ == nullptr) { // Create() failed.
+				std::cerr << "error: GetCols() frame buffer is nullptr." << std::endl;
+
+				return 0;
+			}
+
+			size_t cols{ 0 };
+			std::memcpy(&cols, buffer_.get() + sizeof(size_t), sizeof(size_t));
+
+			return cols;
+		}
+
+
+		// Return the index where the frame begins.
+		[[nodiscard]] constexpr size_t GetDataIndex() const // The result is computed during compilation.
+		{
+			return kDataIndex;
+		}
+
+		// __Buffer indicators
+
+
+		Buffer buffer_{}; // [rows][cols][padding][....frame data....]
+
+		std::unique_ptr<CharHistogram> tracked_histogram_{}; // See: TrackHistogram().
+		std::vector<std::vector<Rect>> clip_stack_{}; // The clip region (disjoint rects) per PushClip(). See: ClipRect().
+		mutable std::vector<char> initialized_cols_{}; // A lazy frame: per col (char, not bool: written by the threads of disjoint cols). See: Lazy().
+		StripeCallback stripe_callback_{}; // See: SetStripeCallback().
+		size_t stripe_cols_{ kDefaultStripeCols };
+	};
+
+
+	static_assert(std::is_nothrow_move_constructible_v<Frame> && std::is_nothrow_move_assignable_v<Frame>);
+
+
+	//	FramePool class: Recycles the buffers of released frames for later frames of the same dimensions.
+	//
+	//	- Acquire() reuses a free buffer of the requested rows x cols (a "hit"), or creates a new frame.
+	//	- A reused buffer is reset lazily: on Acquire() (not on Release()), serially, in parallel or not at all
+	//	  (ResetMode::kNone: for callers that overwrite the whole frame anyway).
+	//	- Up to max_free_per_size buffers are kept per dimensions; further released buffers are freed.
+	//	- Only buffers as Acquire() makes them are kept: from the pool's resource (not borrowed, see Frame::Adopt()) and of
+	//	  the default encoding (kWhiteZero). Other released frames are "rejected" (freed, or left to their owner).
+	//	- Acquire() / Release() may be called from several threads (the free lists are guarded by a mutex; resetting runs outside it).
+
+	class FramePool final
+	{
+	public:
+
+		enum class ResetMode { kSerial, kParallel, kNone };
+
+
+		// Pool counters:
+		struct Stats final
+		{
+			size_t acquires{ 0 }, hits{ 0 }, allocations{ 0 }, releases{ 0 }, drops{ 0 }, rejects{ 0 };
+
+			[[nodiscard]] double HitRate() const
+			{
+				return acquires > 0 ? static_cast<double>(hits) / acquires : 0.0;
+			}
+		};
+
+
+		// Constructor (n: reset threads, for ResetMode::kParallel; resource: where new frames are allocated from):
+		explicit FramePool(const ResetMode reset_mode = ResetMode::kSerial, const size_t n = 1, const size_t max_free_per_size = 2,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: reset_mode_{ reset_mode }, n_{ n }, max_free_per_size_{ max_free_per_size }, resource_{ resource }
+		{
+		}
+
+
+		// Get a blank frame of rows x cols (see ResetMode).
+		[[nodiscard]] Frame Acquire(const size_t rows, const size_t cols)
+		{
+			Frame::Buffer buffer{};
+			{
+				std::scoped_lock lock{ mutex_ };
+				++stats_.acquires;
+
+				auto it{ free_.find({ rows, cols }) };
+				if (it != free_.end() && !it->second.empty()) {
+					buffer = std::move(it->second.back());
+					it->second.pop_back();
+					++stats_.hits;
+				}
+				else {
+					++stats_.allocations;
+				}
+			}
+
+			if (buffer == nullptr) {
+				return Frame{ rows, cols, resource_ };
+			}
+
+			Frame frame{ std::move(buffer) };
+			if (reset_mode_ != ResetMode::kNone) {
+				[[maybe_unused]] const bool ok{ frame.Reset(reset_mode_ == ResetMode::kParallel ? n_ : 1) };
+			}
+
+			return frame;
+		}
+
+
+		// Return the buffer of a frame (no longer used) to the pool.
+		void Release(Frame&& frame)
+		{
+			if (frame.buffer_ == nullptr) { // Create() failed (or moved from).
+				return;
+			}
+
+			const std::pair<size_t, size_t> dimensions{ frame.GetRows(), frame.GetCols() };
+
+			std::scoped_lock lock{ mutex_ };
+			++stats_.releases;
+
+			if (frame.buffer_.get_deleter().resource != resource_ || frame.GetEncoding() != Frame::PixelEncoding::kWhiteZero) {
+				++stats_.rejects; // (Not of this pool: freed with frame, or left to its owner.)
+				return;
+			}
+
+			auto& buffers{ free_[dimensions] };
+			if (buffers.size() < max_free_per_size_) {
+				buffers.push_back(std::move(frame.buffer_));
+			}
+			else {
+				++stats_.drops; // (Freed with frame.)
+			}
+		}
+
+
+		[[nodiscard]] Stats GetStats() const
+		{
+			std::scoped_lock lock{ mutex_ };
+
+			return stats_;
+		}
+
+
+		// Print the pool counters.
+		void PrintStats() const
+		{
+			const Stats stats{ GetStats() };
+			std::cout << "pool (acquires: " << stats.acquires << ", allocations: " << stats.allocations << ", hits: " << stats.hits
+				<< ", hit rate: " << std::format("{:.2f}", stats.HitRate()) << ", releases: " << stats.releases << ", drops: " << stats.drops << ", rejects: " << stats.rejects << ")" << std::endl;
+		}
+
+	private:
+
+		const ResetMode reset_mode_;
+		const size_t n_, max_free_per_size_;
+		std::pmr::memory_resource* const resource_;
+
+		mutable std::mutex mutex_{};
+		std::map<std::pair<size_t, size_t>, std::vector<Frame::Buffer>> free_{}; // Free buffers per (rows, cols).
+		Stats stats_{};
+	};
+
+
+	//	DrawPlan class: A draw of a rect (or a batch of rects) compiled against a frame, to be executed repeatedly
+	//	(e.g. fixed UI layouts drawn every frame).
+	//
+	//	- Compile() does once what Draw() does per call: the sanity checks, the thread count, the segments and the
+	//	  kernel of each piece (one span fill for whole cols, a fill per col otherwise).
+	//	- The segments are disjoint col bands across all the rects, so the rects of a batch may overlap.
+	//	- Optionally, overdraw is eliminated first: the regions of a rect that later rects of the batch overwrite are
+	//	  subtracted (SubtractOverdraw()), so each char is written once.
+	//	- Execute() only fills: no checks, no allocation (with 1 thread), no printing.
+	//	- The plan holds views into the frame buffer: the buffer must outlive the plan (moving the frame keeps it).
+	//	- Frames that track a histogram are rejected (Draw() keeps it up to date; a plan does not).
+
+	class DrawPlan final
+	{
+	public:
+
+		DrawPlan() = default; // (Empty plan: executes nothing.)
+
+
+		// Compile drawing rects (a batch, in order) in frame with optimized_n threads (an empty plan on failure):
+		[[nodiscard]] static DrawPlan Compile(const Frame& frame, std::span<const FrameRect> rects, const size_t n = 1, const bool eliminate_overdraw = false)
+		{
+			if (rects.empty() || frame.GetTrackedHistogram() != nullptr) {
+				std::cerr << "error: DrawPlan::Compile() no rects, or the frame tracks a histogram." << std::endl;
+
+				return {};
+			}
+
+			size_t y_min{ frame.GetCols() }, y_max{ 0 };
+			for (const FrameRect& rect : rects) {
+				if (!frame.DrawSanityChecks(rect)) {
+					std::cerr << "error: DrawPlan::Compile() sanity check failed." << std::endl;
+
+					return {};
+				}
+				y_min = std::min(y_min, rect.y1);
+				y_max = std::max(y_max, rect.y2);
+			}
+
+			DrawPlan plan{};
+			plan.rect_count_ = rects.size();
+			plan.requested_chars_ = CountChars(rects);
+
+			std::vector<FrameRect> disjoint;
+			if (eliminate_overdraw) { // (Before the split into bands.)
+				disjoint = SubtractOverdraw(rects);
+				rects = disjoint;
+			}
+			plan.chars_ = CountChars(rects);
+			plan.white_ = frame.GetWhite();
+
+			// Split the cols the rects span into optimized_n bands (as PrepareSegments()), and each rect into its
+			// pieces per band:
+			const size_t cols{ (y_max - y_min) + 1 };
+			const size_t optimized_n{ OptimizeThreadCount(n, cols) };
+			const size_t band_size{ cols / optimized_n }, remainder{ cols % optimized_n };
+
+			const FrameView view{ frame.View() };
+
+			plan.bands_.resize(optimized_n);
+
+			size_t from{ y_min };
+			for (size_t i = 0; i < optimized_n; ++i) {
+				const size_t to{ from + band_size + (i < remainder ? 1 : 0) - 1 };
+
+				for (const FrameRect& rect : rects) {
+					if (rect.y2 < from || rect.y1 > to) {
+						continue; // (Not in this band.)
+					}
+
+					const FrameView piece{ view.SubView({ rect.x1, std::max(rect.y1, from), rect.x2, std::min(rect.y2, to) }) };
+					plan.bands_[i].push_back({ piece, piece.IsContiguous() ? Kernel::kSpan : Kernel::kCols });
+				}
+
+				from = to + 1;
+			}
+
+			return plan;
+		}
+
+
+		// Compile drawing a single rect in frame with optimized_n threads (an empty plan on failure):
+		[[nodiscard]] static DrawPlan Compile(const Frame& frame, const FrameRect& rect, const size_t n = 1)
+		{
+			return Compile(frame, std::span<const FrameRect>{ &rect, 1 }, n);
+		}
+
+
+		// Draw "White" (quietly): a band per thread, on the execution backend (see RunParallel()).
+		void Execute() const
+		{
+			if (bands_.size() > 1) { // Run with worker-threads:
+				RunParallel(bands_.size(), [&](const size_t i) { ExecuteBand(bands_[i], white_); });
+			}
+			else if (!bands_.empty()) { // Run with main-thread:
+				ExecuteBand(bands_.front(), white_);
+			}
+		}
+
+
+		[[nodiscard]] bool IsEmpty() const { return bands_.empty(); }
+		[[nodiscard]] size_t GetThreadCount() const { return bands_.size(); }
+		[[nodiscard]] size_t GetRectCount() const { return rect_count_; }
+		[[nodiscard]] uint64_t GetRequestedChars() const { return requested_chars_; } // (Of the rects as given.)
+		[[nodiscard]] uint64_t GetChars() const { return chars_; } // (Written per Execute().)
+
+
+		// Overdraw ratio: requested chars per written char (1: no overdraw, or eliminated).
+		[[nodiscard]] double GetOverdrawRatio() const
+		{
+			return chars_ > 0 ? static_cast<double>(requested_chars_) / chars_ : 1.0;
+		}
+
+
+		// Subtract from each rect what later rects (of rects, in order) overwrite: disjoint rects covering the same chars.
+		// (See: SubtractRects().)
+		[[nodiscard]] static std::vector<FrameRect> SubtractOverdraw(const std::span<const FrameRect> rects)
+		{
+			return SubtractRects(rects);
+		}
+
+	private:
+
+		enum class Kernel { kSpan, kCols };
+
+
+		// A rect within a band:
+		struct Piece final
+		{
+			FrameView view;
+			Kernel kernel;
+		};
+
+
+		// (Run in the context of multiple threads; no syncronization! - the bands do not overlap.)
+		static void ExecuteBand(const std::vector<Piece>& band, const char white)
+		{
+			for (const Piece& piece : band) {
+				if (piece.kernel == Kernel::kSpan) { // Whole cols: a single span.
+					std::ranges::fill(piece.view.Span(), white); // Draw "White".
+				}
+				else {
+					for (std::span<char> col : piece.view.Cols()) {
+						std::ranges::fill(col, white); // Draw "White".
+					}
+				}
+			}
+		}
+
+
+		static uint64_t CountChars(const std::span<const FrameRect> rects)
+		{
+			uint64_t chars{ 0 };
+			for (const FrameRect& rect : rects) {
+				chars += static_cast<uint64_t>(rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1);
+			}
+			return chars;
+		}
+
+
+		std::vector<std::vector<Piece>> bands_{}; // Per thread.
+		size_t rect_count_{ 0 };
+		uint64_t requested_chars_{ 0 }, chars_{ 0 };
+		char white_{ 0x00 }; // (Of the frame. See: Frame::GetWhite().)
+	};
+
+
+	//	BoundedQueue class template: A bounded lock-free multi-producer multi-consumer queue (Vyukov's array queue).
+	//
+	//	- Each cell carries a sequence number that tells whose turn it is (a producer's or a consumer's), so a push / pop
+	//	  is one CAS on a position and a release store of the cell sequence: no locks, no allocation after construction.
+	//	- The capacity is rounded up to a power of 2. TryPush() / TryPop() return false when full / empty (no waiting).
+
+	template<typename T>
+	class BoundedQueue final
+	{
+	public:
+
+		explicit BoundedQueue(const size_t capacity)
+			: mask_{ std::bit_ceil(std::max(capacity, static_cast<size_t>(2))) - 1 }, cells_{ std::make_unique<Cell[]>(mask_ + 1) }
+		{
+			for (size_t i = 0; i <= mask_; ++i) {
+				cells_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+
+		// Push value (false if the queue is full).
+		[[nodiscard]] bool TryPush(T value)
+		{
+			size_t position{ enqueue_position_.load(std::memory_order_relaxed) };
+			for (;;) {
+				Cell& cell{ cells_[position & mask_] };
+				const size_t sequence{ cell.sequence.load(std::memory_order_acquire) };
+				const auto diff{ static_cast<std::ptrdiff_t>(sequence - position) };
+
+				if (diff == 0) { // The cell is free at this position: claim it.
+					if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						cell.value = std::move(value);
+						cell.sequence.store(position + 1, std::memory_order_release); // (Publish to consumers.)
+
+						return true;
+					}
+				}
+				else if (diff < 0) { // The cell still holds the value of the previous lap: full.
+					return false;
+				}
+				else { // Another producer claimed it: reload.
+					position = enqueue_position_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+
+		// Pop into value (false if the queue is empty).
+		[[nodiscard]] bool TryPop(T& value)
+		{
+			size_t position{ dequeue_position_.load(std::memory_order_relaxed) };
+			for (;;) {
+				Cell& cell{ cells_[position & mask_] };
+				const size_t sequence{ cell.sequence.load(std::memory_order_acquire) };
+				const auto diff{ static_cast<std::ptrdiff_t>(sequence - (position + 1)) };
+
+				if (diff == 0) { // The cell holds a value at this position: claim it.
+					if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						value = std::move(cell.value);
+						cell.sequence.store(position + mask_ + 1, std::memory_order_release); // (Free for the next lap.)
+
+						return true;
+					}
+				}
+				else if (diff < 0) { // Not published yet: empty.
+					return false;
+				}
+				else { // Another consumer claimed it: reload.
+					position = dequeue_position_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+
+		// The number of queued values (approximate while pushing / popping).
+		[[nodiscard]] size_t GetSize() const
+		{
+			const size_t dequeue_position{ dequeue_position_.load(std::memory_order_relaxed) };
+			const size_t enqueue_position{ enqueue_position_.load(std::memory_order_relaxed) };
+
+			return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0;
+		}
+
+
+		[[nodiscard]] size_t GetCapacity() const { return mask_ + 1; }
+
+	private:
+
+		struct Cell final
+		{
+			std::atomic<size_t> sequence{ 0 };
+			T value{};
+		};
+
+		const size_t mask_;
+		const std::unique_ptr<Cell[]> cells_;
+
+		// (Each position on its own cache line: producers and consumers do not contend on it.)
+		alignas(64) std::atomic<size_t> enqueue_position_{ 0 };
+		alignas(64) std::atomic<size_t> dequeue_position_{ 0 };
+	};
+
+
+	//	DrawQueue class: Draw commands submitted concurrently (e.g. by several subsystems) and drawn by a fixed pool of
+	//	consumer threads, instead of each subsystem calling Draw() with its own threads (oversubscribing the machine).
+	//
+	//	- Each consumer owns a band of the frame cols (as the segments of Draw()) and a BoundedQueue of the pieces
+	//	  of the commands in its band: Submit() splits a rect by the bands, so consumers never write the same cols.
+	//	- Submit() never locks; a full band queue makes it wait (back-pressure, counted in the stats).
+	//	- Idle consumers sleep on an atomic (std::atomic::wait), woken by Submit(). Flush() waits for all submitted commands.
+	//	- The queue holds a view of the frame buffer (as DrawPlan): the buffer must outlive the queue (moving the frame
+	//	  keeps it); frames that track a histogram are rejected.
+
+	class DrawQueue final
+	{
+	public:
+
+		// Queue counters (depth: queued pieces of a band queue, sampled on Submit()):
+		struct Stats final
+		{
+			size_t commands{ 0 }, pieces{ 0 }, full_waits{ 0 }, max_depth{ 0 };
+			std::chrono::nanoseconds enqueue_total{ 0 }, enqueue_max{ 0 };
+
+			[[nodiscard]] std::chrono::nanoseconds AverageEnqueue() const
+			{
+				return commands > 0 ? enqueue_total / static_cast<int64_t>(commands) : std::chrono::nanoseconds{ 0 };
+			}
+		};
+
+
+		// Constructor (consumers: threads, at most one per col; capacity: pieces per band queue):
+		DrawQueue(const Frame& frame, const size_t consumers = 1, const size_t capacity = 1024) : view_{ frame.View() }, white_{ frame.GetWhite() }
+		{
+			if (frame.GetTrackedHistogram() != nullptr || frame.View().IsEmpty()) {
+				std::cerr << "error: DrawQueue() frame buffer is nullptr, or the frame tracks a histogram." << std::endl;
+
+				return; // (No consumers: Submit() fails.)
+			}
+
+			const size_t optimized_n{ OptimizeThreadCount(consumers, frame.GetCols()) };
+
+			std::cout << "draw queue (consumers: " << optimized_n << ", capacity: " << capacity << " per consumer)" << std::endl;
+
+			std::vector<std::pair<size_t, size_t>> segments(optimized_n);
+			PrepareSegments(frame.GetCols(), segments);
+
+			consumers_.reserve(optimized_n);
+			for (const auto& segment : segments) {
+				consumers_.push_back(std::make_unique<Consumer>(segment, capacity));
+			}
+			for (auto& consumer : consumers_) {
+				consumer->thread = std::jthread{ [this, consumer = consumer.get()](const std::stop_token stop) { ConsumerThread(*consumer, white_, stop); } };
+			}
+		}
+
+		DrawQueue(const DrawQueue&) = delete;
+		DrawQueue& operator=(const DrawQueue&) = delete;
+
+
+		// Destructor: draws the queued commands and stops the consumers (Submit() must no longer be called).
+		~DrawQueue()
+		{
+			for (auto& consumer : consumers_) {
+				consumer->thread.request_stop();
+				consumer->signal.fetch_add(1, std::memory_order_release);
+				consumer->signal.notify_one();
+			}
+		} // (Consumer threads join here.)
+
+
+		// Queue drawing "White" in rect (thread safe; waits while a band queue is full).
+		bool Submit(const Frame::Rect& rect)
+		{
+			if (consumers_.empty() || rect.x2 < rect.x1 || rect.y2 < rect.y1 || rect.x2 > view_.GetRows() - 1 || rect.y2 > view_.GetCols() - 1) {
+				std::cerr << "error: DrawQueue::Submit() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const auto start_time = Now(); // <-- Start.
+
+			size_t pieces{ 0 }, full_waits{ 0 }, max_depth{ 0 };
+			for (auto& consumer : consumers_) {
+				if (rect.y2 < consumer->band.first || rect.y1 > consumer->band.second) {
+					continue; // (Not in this band.)
+				}
+
+				const FrameView piece{ view_.SubView({ rect.x1, std::max(rect.y1, consumer->band.first), rect.x2, std::min(rect.y2, consumer->band.second) }) };
+				consumer->submitted.fetch_add(1, std::memory_order_relaxed);
+				while (!consumer->queue.TryPush(piece)) {
+					++full_waits;
+					std::this_thread::yield();
+				}
+				max_depth = std::max(max_depth, consumer->queue.GetSize());
+				++pieces;
+
+				consumer->signal.fetch_add(1, std::memory_order_release);
+				consumer->signal.notify_one();
+			}
+
+			const auto duration{ std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time) }; // <-- Finish.
+
+			commands_.fetch_add(1, std::memory_order_relaxed);
+			pieces_.fetch_add(pieces, std::memory_order_relaxed);
+			full_waits_.fetch_add(full_waits, std::memory_order_relaxed);
+			UpdateMax(max_depth_, max_depth);
+			enqueue_total_ns_.fetch_add(static_cast<uint64_t>(duration.count()), std::memory_order_relaxed);
+			UpdateMax(enqueue_max_ns_, static_cast<uint64_t>(duration.count()));
+
+			return true;
+		}
+
+
+		// Wait until every command submitted so far is drawn.
+		void Flush() const
+		{
+			for (const auto& consumer : consumers_) {
+				while (consumer->completed.load(std::memory_order_acquire) < consumer->submitted.load(std::memory_order_relaxed)) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+
+		[[nodiscard]] Stats GetStats() const
+		{
+			return { commands_.load(std::memory_order_relaxed), pieces_.load(std::memory_order_relaxed), full_waits_.load(std::memory_order_relaxed),
+				static_cast<size_t>(max_depth_.load(std::memory_order_relaxed)),
+				std::chrono::nanoseconds{ static_cast<int64_t>(enqueue_total_ns_.load(std::memory_order_relaxed)) }, std::chrono::nanoseconds{ static_cast<int64_t>(enqueue_max_ns_.load(std::memory_order_relaxed)) } };
+		}
+
+
+		// Print the queue counters.
+		void PrintStats() const
+		{
+			const Stats stats{ GetStats() };
+			std::cout << "queue (commands: " << stats.commands << ", pieces: " << stats.pieces << ", max depth: " << stats.max_depth << ", full waits: " << stats.full_waits
+				<< ", enqueue latency avg: " << stats.AverageEnqueue().count() << " ns, max: " << stats.enqueue_max.count() << " ns)" << std::endl;
+		}
+
+	private:
+
+		// A consumer thread with its band of cols and the queue of the pieces in it:
+		struct Consumer final
+		{
+			Consumer(const std::pair<size_t, size_t> band, const size_t capacity) : band{ band }, queue{ capacity } {}
+
+			const std::pair<size_t, size_t> band;
+			BoundedQueue<FrameView> queue;
+			std::atomic<uint32_t> signal{ 0 }; // (Bumped on Submit(): wakes the consumer.)
+			std::atomic<size_t> submitted{ 0 }, completed{ 0 };
+			std::jthread thread{};
+		};
+
+
+		// (Run in the context of multiple threads; no syncronization of the frame! - the bands do not overlap.)
+		static void ConsumerThread(Consumer& consumer, const char white, const std::stop_token stop)
+		{
+			for (;;) {
+				const uint32_t signal{ consumer.signal.load(std::memory_order_acquire) };
+
+				FrameView piece{};
+				while (consumer.queue.TryPop(piece)) {
+					if (piece.IsContiguous()) { // Whole cols: a single span.
+						std::ranges::fill(piece.Span(), white); // Draw "White".
+					}
+					else {
+						for (std::span<char> col : piece.Cols()) {
+							std::ranges::fill(col, white); // Draw "White".
+						}
+					}
+					consumer.completed.fetch_add(1, std::memory_order_release);
+				}
+
+				if (stop.stop_requested()) {
+					return;
+				}
+
+				consumer.signal.wait(signal, std::memory_order_acquire); // (Returns at once if Submit() bumped it since.)
+			}
+		}
+
+
+		static void UpdateMax(std::atomic<uint64_t>& max, const uint64_t value)
+		{
+			uint64_t current{ max.load(std::memory_order_relaxed) };
+			while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+		}
+
+
+		const FrameView view_; // (Of the frame buffer: all cols initialized, for a lazy frame.)
+		const char white_;
+		std::vector<std::unique_ptr<Consumer>> consumers_{};
+
+		std::atomic<size_t> commands_{ 0 }, pieces_{ 0 }, full_waits_{ 0 };
+		std::atomic<uint64_t> max_depth_{ 0 }, enqueue_total_ns_{ 0 }, enqueue_max_ns_{ 0 };
+	};
+
+
+	//	FrameScheduler class: Paces draws at a fixed cadence (e.g. 60 / 120 Hz): the draws pending at a tick form an
+	//	epoch, to be drawn before its deadline (the next tick).
+	//
+	//	- Draws run by priority (high, normal, low). When a draw is estimated to end past the deadline (from the measured
+	//	  time per char), a low draw is shed (dropped) and a normal draw deferred to the next epoch, where it runs as high
+	//	  (deferred once at most); high draws always run.
+	//	- Each epoch records its duration, whether it missed its deadline, and a histogram of its draws' latency
+	//	  (submitted -> drawn: a deferred draw carries its wait).
+	//	- Draws are compiled into DrawPlans on Submit(). Submit() may be called from several threads (the pending draws
+	//	  are guarded by a mutex); RunEpochs() runs the epochs on the calling thread (+ the draw threads).
+	//	- Submit() compiles against the frame object itself: the Frame must not be moved or destroyed while the scheduler
+	//	  exists (unlike a DrawPlan / DrawQueue, which only need its buffer).
+
+	class FrameScheduler final
+	{
+	public:
+
+		enum class Priority { kHigh, kNormal, kLow };
+
+
+		// Latency histogram: bucket i counts latencies of [2^i, 2^(i+1)) microseconds (bucket 0: also < 1 microsecond).
+		using LatencyHistogram = std::array<size_t, 24>;
+
+
+		// Epoch counters:
+		struct EpochStats final
+		{
+			size_t epoch{ 0 }, drawn{ 0 }, shed{ 0 }, deferred{ 0 };
+			std::chrono::microseconds duration{ 0 };
+			bool missed{ false };
+			LatencyHistogram latencies{};
+		};
+
+
+		// Constructor (period: between ticks; n: threads per draw):
+		FrameScheduler(const Frame& frame, const std::chrono::microseconds period, const size_t n = 1) : frame_{ frame }, period_{ period }, n_{ n } {}
+
+
+		// Queue drawing "White" in rect for the next epoch (thread safe).
+		bool Submit(const FrameRect& rect, const Priority priority = Priority::kNormal)
+		{
+			DrawPlan plan{ DrawPlan::Compile(frame_, rect, n_) };
+			if (plan.IsEmpty()) {
+				std::cerr << "error: FrameScheduler::Submit() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			std::scoped_lock lock{ mutex_ };
+			pending_.push_back({ std::move(plan), (rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1), priority, Now() });
+
+			return true;
+		}
+
+
+		// Run epochs, one per tick: before_epoch(epoch) first (e.g. to submit the draws of the epoch), then the draws;
+		// then sleep until the next tick (an epoch that overruns its deadline skips the ticks it missed).
+		template<typename Function>
+		void RunEpochs(const size_t epochs, Function&& before_epoch)
+		{
+			auto tick{ Now() };
+			for (size_t i = 0; i < epochs; ++i) {
+				before_epoch(i);
+				RunEpoch(tick, tick + period_);
+
+				tick += period_;
+				const auto now{ Now() };
+				if (now > tick) { // Overran: resume at the next tick.
+					const auto missed_ticks{ (now - tick) / period_ + 1 };
+					skipped_ticks_ += static_cast<size_t>(missed_ticks);
+					tick += missed_ticks * period_;
+				}
+				std::this_thread::sleep_until(tick);
+			}
+		}
+
+
+		[[nodiscard]] const std::vector<EpochStats>& GetEpochStats() const { return epochs_; }
+		[[nodiscard]] size_t GetSkippedTicks() const { return skipped_ticks_; }
+
+
+		[[nodiscard]] size_t GetPendingCount() const
+		{
+			std::scoped_lock lock{ mutex_ };
+
+			return pending_.size();
+		}
+
+
+		// Print the counters and the latency histogram of each epoch.
+		void PrintStats() const
+		{
+			std::cout << "scheduler (period: " << period_.count() << " microseconds, epochs: " << epochs_.size() << ", skipped ticks: " << skipped_ticks_ << ")" << std::endl;
+			for (const EpochStats& stats : epochs_) {
+				std::cout << "* epoch " << stats.epoch << ": drawn: " << stats.drawn << ", shed: " << stats.shed << ", deferred: " << stats.deferred
+					<< ", time: " << stats.duration.count() << " microseconds (" << (stats.missed ? "missed" : "met") << " deadline), latency:";
+				for (size_t i = 0; i < stats.latencies.size(); ++i) {
+					if (stats.latencies[i] > 0) {
+						std::cout << " <" << (static_cast<size_t>(2) << i) << "us: " << stats.latencies[i];
+					}
+				}
+				std::cout << std::endl;
+			}
+		}
+
+	private:
+
+		// A submitted draw:
+		struct Draw final
+		{
+			DrawPlan plan;
+			size_t chars;
+			Priority priority;
+			std::chrono::steady_clock::time_point submitted;
+		};
+
+
+		// Draw the pending draws by priority until deadline (see the class comment).
+		void RunEpoch(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point deadline)
+		{
+			std::vector<Draw> draws;
+			{
+				std::scoped_lock lock{ mutex_ };
+				draws.swap(pending_);
+			}
+			std::ranges::stable_sort(draws, {}, &Draw::priority); // (Deferred draws first within their priority.)
+
+			EpochStats stats{ epochs_.size() };
+			std::vector<Draw> deferred;
+
+			for (Draw& draw : draws) {
+				const auto draw_start{ Now() };
+
+				const double ns_per_char{ measured_chars_ > 0.0 ? measured_ns_ / measured_chars_ : 0.0 };
+				const auto estimate{ std::chrono::nanoseconds{ static_cast<int64_t>(ns_per_char * draw.chars) } };
+				if (draw.priority != Priority::kHigh && draw_start + estimate > deadline) { // Running late:
+					if (draw.priority == Priority::kLow) {
+						++stats.shed;
+					}
+					else {
+						++stats.deferred;
+						draw.priority = Priority::kHigh;
+						deferred.push_back(std::move(draw));
+					}
+					continue;
+				}
+
+				draw.plan.Execute();
+
+				const auto draw_end{ Now() };
+				// (EWMA of both: their ratio weighs the draws by size, so the per-draw overhead of small draws does not dominate.)
+				measured_ns_ += 0.25 * (std::chrono::duration<double, std::nano>(draw_end - draw_start).count() - measured_ns_);
+				measured_chars_ += 0.25 * (draw.chars - measured_chars_);
+
+				const auto latency_us{ std::chrono::duration_cast<std::chrono::microseconds>(draw_end - draw.submitted).count() };
+				++stats.latencies[std::min(static_cast<size_t>(std::bit_width(static_cast<uint64_t>(std::max<int64_t>(latency_us, 1)))) - 1, stats.latencies.size() - 1)];
+				++stats.drawn;
+			}
+
+			const auto end{ Now() };
+			stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+			stats.missed = end > deadline;
+			epochs_.push_back(stats);
+
+			if (!deferred.empty()) { // (Ahead of the draws submitted meanwhile.)
+				std::scoped_lock lock{ mutex_ };
+				pending_.insert(pending_.begin(), std::make_move_iterator(deferred.begin()), std::make_move_iterator(deferred.end()));
+			}
+		}
+
+
+		const Frame& frame_; // (Must not move: see the class comment.)
+		const std::chrono::microseconds period_;
+		const size_t n_;
+
+		mutable std::mutex mutex_{};
+		std::vector<Draw> pending_{};
+
+		double measured_ns_{ 0.0 }, measured_chars_{ 0.0 }; // Measured draw cost (EWMAs of the time and the chars of the draws).
+		std::vector<EpochStats> epochs_{};
+		size_t skipped_ticks_{ 0 };
+	};
+
+
+	//	DisplayList class: Draw calls recorded once, optimized, and replayed on any number of frames.
+	//
+	//	- Optimize() runs passes over the recorded rects (all draw the same "White", so their order does not matter):
+	//	  * drop: duplicates and rects fully inside another rect (occluded).
+	//	  * merge: rects that form a rect together (the same rows and adjacent / overlapping cols - contiguous in the
+	//	    col-major layout - or the same cols and adjacent / overlapping rows), until none is left.
+	//	  * sort: by the address of the first char (col, then row), so a replay streams through memory.
+	//	- Replay() compiles the list into a DrawPlan against a frame (checked against its dimensions) and executes it.
+
+	class DisplayList final
+	{
+	public:
+
+		// Record drawing "White" in rect (checked against a frame on Replay()).
+		bool Record(const FrameRect& rect)
+		{
+			if (rect.x2 < rect.x1 || rect.y2 < rect.y1) {
+				std::cerr << "error: DisplayList::Record() x1-y1 is beyond x2-y2." << std::endl;
+
+				return false;
+			}
+
+			rects_.push_back(rect);
+
+			return true;
+		}
+
+
+		// Run the optimization passes (see the class comment).
+		void Optimize()
+		{
+			if (rects_.empty()) { // (Nothing recorded.)
+				return;
+			}
+
+			const size_t rects{ rects_.size() };
+			const uint64_t chars{ GetChars() };
+
+			DropOccluded();
+			while (MergeRects()) {}
+			DropOccluded(); // (Rects inside merged rects.)
+			std::ranges::sort(rects_, {}, [](const FrameRect& rect) { return std::pair{ rect.y1, rect.x1 }; }); // (Address order.)
+
+			std::cout << "display list optimize (rects: " << rects << " -> " << rects_.size() << ", chars: " << FormatCharCount(chars) << " -> " << FormatCharCount(GetChars()) << ")" << std::endl;
+		}
+
+
+		// Draw the list in frame with optimized_n threads.
+		bool Replay(const Frame& frame, const size_t n = 1) const
+		{
+			const DrawPlan plan{ DrawPlan::Compile(frame, rects_, n) };
+			if (plan.IsEmpty()) {
+				std::cerr << "error: DisplayList::Replay() compile failed." << std::endl;
+
+				return false;
+			}
+
+			plan.Execute();
+
+			return true;
+		}
+
+
+		[[nodiscard]] std::span<const FrameRect> GetRects() const { return rects_; }
+
+
+		// Chars drawn by the list (overlapping chars counted per rect).
+		[[nodiscard]] uint64_t GetChars() const
+		{
+			uint64_t chars{ 0 };
+			for (const FrameRect& rect : rects_) {
+				chars += static_cast<uint64_t>(rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1);
+			}
+			return chars;
+		}
+
+	private:
+
+		[[nodiscard]] static bool Contains(const FrameRect& outer, const FrameRect& inner)
+		{
+			return outer.x1 <= inner.x1 && inner.x2 <= outer.x2 && outer.y1 <= inner.y1 && inner.y2 <= outer.y2;
+		}
+
+
+		// Drop the rects inside another (kept) rect, including duplicates (the first is kept).
+		void DropOccluded()
+		{
+			std::vector<bool> dropped(rects_.size(), false);
+			for (size_t i = 0; i < rects_.size(); ++i) {
+				for (size_t j = 0; j < rects_.size() && !dropped[i]; ++j) {
+					dropped[i] = i != j && !dropped[j] && Contains(rects_[j], rects_[i]) && (!Contains(rects_[i], rects_[j]) || j < i);
+				}
+			}
+
+			size_t i{ 0 };
+			std::erase_if(rects_, [&](const FrameRect&) { return dropped[i++]; });
+		}
+
+
+		// Merge the rects that form a rect together, in one pass of each direction (true if any was merged).
+		bool MergeRects()
+		{
+			const size_t rects{ rects_.size() };
+
+			// The same rows, adjacent / overlapping cols:
+			std::ranges::sort(rects_, {}, [](const FrameRect& rect) { return std::tuple{ rect.x1, rect.x2, rect.y1 }; });
+			MergeRuns([](const FrameRect& a, const FrameRect& b) { return a.x1 == b.x1 && a.x2 == b.x2 && b.y1 <= a.y2 + 1; },
+				[](FrameRect& a, const FrameRect& b) { a.y2 = std::max(a.y2, b.y2); });
+
+			// The same cols, adjacent / overlapping rows:
+			std::ranges::sort(rects_, {}, [](const FrameRect& rect) { return std::tuple{ rect.y1, rect.y2, rect.x1 }; });
+			MergeRuns([](const FrameRect& a, const FrameRect& b) { return a.y1 == b.y1 && a.y2 == b.y2 && b.x1 <= a.x2 + 1; },
+				[](FrameRect& a, const FrameRect& b) { a.x2 = std::max(a.x2, b.x2); });
+
+			return rects_.size() < rects;
+		}
+
+
+		// Merge each rect into the previous (kept) one while mergeable (rects_ sorted so that mergeable rects follow each other).
+		template<typename Mergeable, typename Merge>
+		void MergeRuns(Mergeable&& mergeable, Merge&& merge)
+		{
+			if (rects_.empty()) {
+				return;
+			}
+
+			size_t kept{ 0 };
+			for (size_t i = 1; i < rects_.size(); ++i) {
+				if (mergeable(rects_[kept], rects_[i])) {
+					merge(rects_[kept], rects_[i]);
+				}
+				else {
+					rects_[++kept] = rects_[i];
+				}
+			}
+			rects_.resize(kept + 1);
+		}
+
+
+		std::vector<FrameRect> rects_{};
+	};
+
+
+	//	Compositor class: Composes a frame from z-ordered layers (the later added on top), each opaque:
+	//	rects filled with a value, or a source frame view copied at a position.
+	//
+	//	- Compose() splits the frame into tiles of kTileRows x kTileCols. Per tile it walks the layers top-down until
+	//	  one covers the whole tile: the layers below are occluded and skipped. Then it draws the visible layers
+	//	  back-to-front, clipped to the tile (each char of a tile is written by its visible layers only).
+	//	- Tiles are composed in parallel: the tile cols are split into segments (disjoint, as Draw()).
+	//	- ComposeNaive() draws every layer fully, back-to-front (the reference).
+	//	- Source views must outlive the compositor; frames that track a histogram are rejected.
+
+	class Compositor final
+	{
+	public:
+
+		static constexpr size_t kTileRows{ 512 }; // (512 chars of a col: contiguous.)
+		static constexpr size_t kTileCols{ 64 };
+
+
+		// Add a layer filling rects with value (on top of the layers added so far).
+		void AddRectLayer(std::vector<FrameRect> rects, const char value)
+		{
+			layers_.push_back({ std::move(rects), value, {}, 0, 0 });
+		}
+
+
+		// Add a layer copying source with its first char at row x, col y (on top of the layers added so far).
+		void AddFrameLayer(const ConstFrameView& source, const size_t x, const size_t y)
+		{
+			if (source.IsEmpty() || source.GetRows() == 0 || source.GetCols() == 0) {
+				std::cerr << "error: Compositor::AddFrameLayer() empty view." << std::endl;
+
+				return;
+			}
+
+			layers_.push_back({ { { x, y, x + source.GetRows() - 1, y + source.GetCols() - 1 } }, 0x00, source, x, y });
+		}
+
+
+		// Compose the layers into frame, tile by tile, with optimized_n worker-threads (see the class comment).
+		bool Compose(const Frame& frame, const size_t n = 1) const
+		{
+			if (!ComposeSanityChecks(frame, "Compose")) {
+				return false;
+			}
+
+			const FrameView view{ frame.View() };
+			const size_t tile_grid_rows{ (view.GetRows() + kTileRows - 1) / kTileRows }, tile_grid_cols{ (view.GetCols() + kTileCols - 1) / kTileCols };
+			const size_t optimized_n{ OptimizeThreadCount(n, tile_grid_cols) };
+
+			std::cout << "compose (layers: " << layers_.size() << ", tiles: " << tile_grid_rows * tile_grid_cols << ", threads: " << optimized_n << ")" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			std::vector<size_t> drawn(optimized_n, 0), culled(optimized_n, 0); // (Layer-tile counts, per thread.)
+			RunSegments(tile_grid_cols, optimized_n, [&](const size_t i, const std::pair<size_t, size_t> segment) {
+				for (size_t tile_col = segment.first; tile_col <= segment.second; ++tile_col) {
+					for (size_t tile_row = 0; tile_row < tile_grid_rows; ++tile_row) {
+						const FrameRect tile{ tile_row * kTileRows, tile_col * kTileCols,
+							std::min((tile_row + 1) * kTileRows, view.GetRows()) - 1, std::min((tile_col + 1) * kTileCols, view.GetCols()) - 1 };
+
+						// Visibility: the lowest layer to draw is the top-most that covers the tile.
+						size_t bottom{ 0 };
+						for (size_t layer = layers_.size(); layer-- > 0;) {
+							if (Covers(layers_[layer], tile)) {
+								bottom = layer;
+								break;
+							}
+						}
+						for (size_t layer = 0; layer < bottom; ++layer) { // (Occluded: only the layers that would draw into the tile.)
+							culled[i] += Intersects(layers_[layer], tile) ? 1 : 0;
+						}
+
+						for (size_t layer = bottom; layer < layers_.size(); ++layer) {
+							drawn[i] += DrawLayer(view, layers_[layer], tile) ? 1 : 0;
+						}
+					}
+				}
+			});
+
+			PrintDuration(start_time); // <-- Finish.
+
+			std::cout << "* layer-tiles drawn: " << std::accumulate(drawn.begin(), drawn.end(), static_cast<size_t>(0))
+				<< ", culled (occluded): " << std::accumulate(culled.begin(), culled.end(), static_cast<size_t>(0)) << std::endl;
+
+			return true;
+		}
+
+
+		// Draw every layer fully into frame, back-to-front, with optimized_n worker-threads (disjoint col segments).
+		bool ComposeNaive(const Frame& frame, const size_t n = 1) const
+		{
+			if (!ComposeSanityChecks(frame, "ComposeNaive")) {
+				return false;
+			}
+
+			const FrameView view{ frame.View() };
+			const size_t optimized_n{ OptimizeThreadCount(n, view.GetCols()) };
+
+			std::cout << "compose naive (layers: " << layers_.size() << ", threads: " << optimized_n << ")" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			RunSegments(view.GetCols(), optimized_n, [&](size_t, const std::pair<size_t, size_t> segment) {
+				const FrameRect clip{ 0, segment.first, view.GetRows() - 1, segment.second };
+				for (const Layer& layer : layers_) {
+					[[maybe_unused]] const bool drawn{ DrawLayer(view, layer, clip) };
+				}
+			});
+
+			PrintDuration(start_time); // <-- Finish.
+
+			return true;
+		}
+
+	private:
+
+		// A layer: rects filled with value, or (source not empty) source copied with its first char at row x, col y
+		// (rects: its placement).
+		struct Layer final
+		{
+			std::vector<FrameRect> rects;
+			char value;
+			ConstFrameView source;
+			size_t x, y;
+		};
+
+
+		// Check that Compose() is feasible: a frame (not tracking a histogram) that holds all the layers.
+		[[nodiscard]] bool ComposeSanityChecks(const Frame& frame, const char* function) const
+		{
+			const ConstFrameView view{ frame.ConstView() };
+
+			bool ok{ !view.IsEmpty() && frame.GetTrackedHistogram() == nullptr };
+			for (const Layer& layer : layers_) {
+				for (const FrameRect& rect : layer.rects) {
+					ok = ok && rect.x1 <= rect.x2 && rect.y1 <= rect.y2 && rect.x2 < view.GetRows() && rect.y2 < view.GetCols();
+				}
+			}
+
+			if (!ok) {
+				std::cerr << "error: Compositor::" << function << "() sanity check failed." << std::endl;
+			}
+
+			return ok;
+		}
+
+
+		// Whether a rect of layer contains the whole tile (conservative: rects that cover the tile only together do not count).
+		[[nodiscard]] static bool Covers(const Layer& layer, const FrameRect& tile)
+		{
+			return std::ranges::any_of(layer.rects, [&](const FrameRect& rect) {
+				return rect.x1 <= tile.x1 && tile.x2 <= rect.x2 && rect.y1 <= tile.y1 && tile.y2 <= rect.y2;
+			});
+		}
+
+
+		// Does any rect of layer overlap the tile?
+		[[nodiscard]] static bool Intersects(const Layer& layer, const FrameRect& tile)
+		{
+			FrameRect intersection{};
+
+			return std::ranges::any_of(layer.rects, [&](const FrameRect& rect) { return IntersectRects(rect, tile, intersection); });
+		}
+
+
+		// Draw layer clipped to clip (true if anything was drawn).
+		static bool DrawLayer(const FrameView& view, const Layer& layer, const FrameRect& clip)
+		{
+			bool drawn{ false };
+			for (const FrameRect& rect : layer.rects) {
+				if (rect.x2 < clip.x1 || rect.x1 > clip.x2 || rect.y2 < clip.y1 || rect.y1 > clip.y2) {
+					continue; // (Outside the clip.)
+				}
+
+				const FrameRect clipped{ std::max(rect.x1, clip.x1), std::max(rect.y1, clip.y1), std::min(rect.x2, clip.x2), std::min(rect.y2, clip.y2) };
+				const FrameView target{ view.SubView(clipped) };
+				if (layer.source.IsEmpty()) {
+					for (std::span<char> col : target.Cols()) {
+						std::ranges::fill(col, layer.value);
+					}
+				}
+				else {
+					const ConstFrameView source{ layer.source.SubView({ clipped.x1 - layer.x, clipped.y1 - layer.y, clipped.x2 - layer.x, clipped.y2 - layer.y }) };
+					for (size_t y = 0; y < target.GetCols(); ++y) {
+						std::ranges::copy(source.Col(y), target.Col(y).begin());
+					}
+				}
+				drawn = true;
+			}
+
+			return drawn;
+		}
+
+
+		std::vector<Layer> layers_{}; // (Bottom to top.)
+	};
+
+
+	//	FixedFrame class template: Represents a rectangular frame of characters of compile-time dimensions
+	//	(e.g. fixed-resolution outputs).
+	//
+	//	- The same data layout as Frame (the rows of a col are contiguous), without the buffer header: Rows and Cols
+	//	  are constexpr, so the index math folds at compile time (no per-col GetRows() / GetDataIndex()).
+	//	- Draw<kRect>() takes the rect as a template argument: it is checked at compile time and the fill length of a
+	//	  col is a constant, so the compiler unrolls the fill (fixed-size stores; one fill for whole cols).
+	//	- Views (View() / ConstView()) work with everything that takes a FrameView (e.g. Frame::DrawView()).
+
+	template<size_t Rows, size_t Cols>
+	class FixedFrame final
+	{
+	public:
+
+		static_assert(Rows > 0 && Cols > 0, "FixedFrame rows and/or cols 0.");
+
+		static constexpr size_t kRows{ Rows };
+		static constexpr size_t kCols{ Cols };
+
+
+		// Constructor to create a blank frame:
+		FixedFrame()
+		{
+			try
+			{
+				storage_ = std::make_unique_for_overwrite<Storage>();
+				std::ranges::fill(storage_->chars, static_cast<char>(0xFF)); // Draw "Black" (0xFF).
+
+				std::cout << "create fixed frame (rows: " << kRows << ", cols: " << kCols << ")" << std::endl;
+			}
+			catch ([[maybe_unused]] const std::bad_alloc& e)
+			{
+				// storage_ stays nullptr.
+				std::cerr << "error: FixedFrame() allocation failed." << std::endl;
+			}
+		}
+
+
+		// Draw "White" in frame with optimized_n worker-threads (rect known at run time).
+		bool Draw(const FrameRect& rect, const size_t n = 1) const
+		{
+			if (rect.x2 < rect.x1 || rect.y2 < rect.y1 || rect.x2 > kRows - 1 || rect.y2 > kCols - 1 || storage_ == nullptr) {
+				std::cerr << "error: FixedFrame::Draw() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const size_t cols_to_draw{ (rect.y2 - rect.y1) + 1 };
+
+			const size_t optimized_n{ OptimizeThreadCount(n, cols_to_draw) };
+
+			std::string note{ "main-thread" };
+			if (optimized_n > 1) {
+				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
+			}
+
+			const auto chars{ FormatCharCount((rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1)) };
+			std::cout << "fixed draw (" << note << ") (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << chars << " chars)" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			RunSegments(cols_to_draw, optimized_n, [&](size_t, const std::pair<size_t, size_t> segment) {
+				// (Each thread writes to an exclusive segments of the buffer => No need for mutex.)
+				char* data{ storage_->chars.data() };
+				for (size_t y = rect.y1 + segment.first; y <= rect.y1 + segment.second; ++y) {
+					std::fill_n(data + rect.x1 + y * kRows, (rect.x2 - rect.x1) + 1, 0x00); // Draw "White" (0x00).
+				}
+			});
+
+			PrintDuration(start_time); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Draw "White" in frame (rect known at compile time; main-thread, no print: for hot paths).
+		// (Only the allocation is checked at run time.)
+		template<FrameRect kRect>
+		bool Draw() const
+		{
+			static_assert(kRect.x1 <= kRect.x2 && kRect.y1 <= kRect.y2, "FixedFrame::Draw() x1-y1 is beyond x2-y2.");
+			static_assert(kRect.x2 < kRows && kRect.y2 < kCols, "FixedFrame::Draw() x2-y2 is exceeds frame.");
+
+			if (storage_ == nullptr) { // The allocation failed.
+				std::cerr << "error: FixedFrame::Draw() frame storage is nullptr." << std::endl;
+
+				return false;
+			}
+
+			constexpr size_t kLength{ (kRect.x2 - kRect.x1) + 1 };
+
+			char* data{ storage_->chars.data() };
+			if constexpr (kLength == kRows) { // Whole cols: one contiguous fill of constant length.
+				std::fill_n(data + kRect.y1 * kRows, kLength * ((kRect.y2 - kRect.y1) + 1), 0x00);
+			}
+			else {
+				for (size_t y = kRect.y1; y <= kRect.y2; ++y) {
+					std::fill_n(data + kRect.x1 + y * kRows, kLength, 0x00); // (Constant length.)
+				}
+			}
+
+			return true;
+		}
+
+
+		// Print the frame.
+		// This is mainly for debug / demo.
+		// Usefull on small frame (~ up to 100 rows).
+		[[nodiscard]] bool PrintFrame() const
+		{
+			if (storage_ == nullptr) {
+				std::cerr << "error: FixedFrame::PrintFrame() frame storage is nullptr." << std::endl;
+
+				return false;
+			}
+
+			std::cout << "frame" << std::endl;
+			for (std::span<const char> col : ConstView().Cols()) {
+				std::ranges::for_each(col, [](char c) { std::cout << ((c == 0) ? '0' : '1'); }); std::cout << std::endl;
+			}
+
+			return true;
+		}
+
+
+		// A non-owning view of the frame data (empty if the allocation failed).
+		[[nodiscard]] FrameView View() const
+		{
+			return storage_ == nullptr ? FrameView{} : FrameView{ storage_->chars.data(), kRows, kCols };
+		}
+
+
+		// A non-owning read-only view of the frame data (empty if the allocation failed).
+		[[nodiscard]] ConstFrameView ConstView() const
+		{
+			return View();
+		}
+
+	private:
+
+		// The frame data, cache line aligned:
+		struct alignas(Frame::kDefaultAlignment) Storage final
+		{
+			std::array<char, Rows * Cols> chars;
+		};
+
+		std::unique_ptr<Storage> storage_{};
+	};
+
+
+	//	TiledFrame class: Represents a sparse rectangular frame of characters, split into fixed-size tiles.
+	//
+	//	tiles_ (std::vector<Tile>)                          	<-- One Tile per tile (tile-col major). See: GetTileIndex().
+	//	+---------------+---------------+---------------+
+	//	| chars         | solid 0x00    | chars         |	<-- Tile row 0: frame rows 0 - (kTileRows - 1).
+	//	+---------------+---------------+---------------+
+	//	| solid 0xFF    | solid 0x00    | chars         |	<-- solid: no chars allocated, every char of the tile is value.
+	//	+---------------+---------------+---------------+
+	//
+	//	- Each tile holds kTileRows x kTileCols chars, laid out like Frame (the rows of a col are contiguous).
+	//	- An untouched tile is solid "Black" (0xFF).
+	//	- A Draw() that covers a whole tile makes it solid in O(1) (releasing its chars); only the tiles at the rect
+	//	  edges are allocated (filled with their solid value first) and written char by char.
+	//	- The edge tiles are allocated in full size too (simple indexing; the few unused chars are never read).
+	//	- Snapshot() shares the chars of every tile with the frame (copy-on-write): a Draw() copies a shared tile
+	//	  before its first write to it, so the snapshot never changes.
+
+	class TiledFrame final
+	{
+	public:
+
+		static constexpr size_t kTileRows{ 4096 };
+		static constexpr size_t kTileCols{ 64 };
+
+
+		// A tile: either solid (chars is nullptr, every char is value) or allocated chars (shared with snapshots):
+		struct Tile final
+		{
+			std::shared_ptr<char[]> chars{};
+			char value{ static_cast<char>(0xFF) }; // (Meaningful only while solid.)
+		};
+
+
+		// Constructor to create a frame with given dimensions (no tile is allocated yet):
+		TiledFrame(const size_t rows, const size_t cols)
+		{
+			[[maybe_unused]] const auto create_ok{ Create(rows, cols) };
+		}
+
+
+		TiledFrame(TiledFrame&&) noexcept = default;
+		TiledFrame& operator=(TiledFrame&&) noexcept = default;
+		TiledFrame& operator=(const TiledFrame&) = delete; // (Copy explicitly: see Snapshot().)
+
+
+		// Take a copy-on-write snapshot of the frame in O(tiles): the tile map is copied, the chars are shared.
+		// The frame keeps drawing while the snapshot is read by other threads (e.g. an encoder); drawing the snapshot
+		// itself copies its tiles as well, so neither ever sees the other's later draws.
+		[[nodiscard]] TiledFrame Snapshot() const
+		{
+			const auto start_time = Now(); // <-- Start.
+
+			TiledFrame snapshot{ *this };
+
+			std::cout << "snapshot (tiles: " << tiles_.size() << ", shared: " << GetMaterializedTileCount() << ")" << std::endl;
+			PrintDuration(start_time); // <-- Finish.
+
+			return snapshot;
+		}
+
+
+		// Draw "White" in frame with optimized_n worker-threads.
+		// The threads split the tile cols of rect, so each thread allocates and writes its own tiles only.
+		bool Draw(const Frame::Rect& rect, const size_t n = 1)
+		{
+			if (!DrawSanityChecks(rect)) {
+				std::cerr << "error: TiledFrame::Draw() sanity check failed." << std::endl;
+
+				return false;
+			}
+
+			const size_t tile_cols_to_draw{ (rect.y2 / kTileCols - rect.y1 / kTileCols) + 1 };
+
+			const size_t optimized_n{ OptimizeThreadCount(n, tile_cols_to_draw) };
+
+			std::string note{ "main-thread" };
+			if (optimized_n > 1) {
+				note = "threads: " + std::to_string(optimized_n - 1) + " worker threads + " + note;
+			}
+
+			const auto chars{ FormatCharCount((rect.x2 - rect.x1 + 1) * (rect.y2 - rect.y1 + 1)) };
+			std::cout << "tiled draw (" << note << ") (x1-y1: " << rect.x1 << "-" << rect.y1 << ", x2-y2: " << rect.x2 << "-" << rect.y2 << ", total: " << chars << " chars)" << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+
+			RunSegments(tile_cols_to_draw, optimized_n, [&](size_t, const std::pair<size_t, size_t> segment) { DrawThread(rect, segment); });
+
+			PrintDuration(start_time); // <-- Finish.
+
+			return true;
+		}
+
+
+		// Print the frame.
+		// This is mainly for debug / demo.
+		// Usefull on small frame (~ up to 100 rows).
+		[[nodiscard]] bool PrintFrame() const
+		{
+			if (tiles_.empty()) { // Create() failed.
+				std::cerr << "error: TiledFrame::PrintFrame() frame is empty." << std::endl;
+
+				return false;
+			}
+
+			std::cout << "frame" << std::endl;
+			for (size_t y = 0; y < cols_; ++y) {
+				for (size_t x = 0; x < rows_; ++x) {
+					std::cout << ((GetPixel(x, y) == 0) ? '0' : '1');
+				}
+				std::cout << std::endl;
+			}
+
+			return true;
+		}
+
+
+		// Get the char at row x, col y.
+		// This is mainly for debug / test (0x00 if out of the frame).
+		[[nodiscard]] char GetPixel(const size_t x, const size_t y) const
+		{
+			if (x >= rows_ || y >= cols_) {
+				std::cerr << "error: TiledFrame::GetPixel() out of the frame." << std::endl;
+
+				return 0x00;
+			}
+
+			const auto& tile{ tiles_[GetTileIndex(x / kTileRows, y / kTileCols)] };
+
+			return (tile.chars == nullptr) ? tile.value : tile.chars[(x % kTileRows) + (y % kTileCols) * kTileRows];
+		}
+
+
+		// Return the number of allocated (non-solid) tiles (out of GetTileCount()).
+		// (Not while drawing.)
+		[[nodiscard]] size_t GetMaterializedTileCount() const
+		{
+			return static_cast<size_t>(std::ranges::count_if(tiles_, [](const Tile& tile) { return tile.chars != nullptr; }));
+		}
+
+
+		// Return the number of allocated tiles shared with a snapshot (or shared by a snapshot with its frame).
+		// (Not while drawing.)
+		[[nodiscard]] size_t GetSharedTileCount() const
+		{
+			return static_cast<size_t>(std::ranges::count_if(tiles_, [](const Tile& tile) { return tile.chars != nullptr && tile.chars.use_count() > 1; }));
+		}
+
+
+		// Return the number of tiles of the frame.
+		[[nodiscard]] size_t GetTileCount() const
+		{
+			return tiles_.size();
+		}
+
+
+		// Return the bytes held by the frame: the allocated tiles and the tile map.
+		// (Not while drawing.)
+		[[nodiscard]] size_t GetMemoryUsage() const
+		{
+			return GetMaterializedTileCount() * kTileRows * kTileCols + tiles_.size() * sizeof(tiles_[0]);
+		}
+
+	protected:
+
+		TiledFrame(const TiledFrame&) = default; // (Shares the tile chars. See: Snapshot().)
+
+
+		// Check that Draw() is feasible.
+		[[nodiscard]] bool DrawSanityChecks(const Frame::Rect& rect) const
+		{
+			return (!(rect.x2 < rect.x1 || rect.y2 < rect.y1 // x1-y1 is beyond x2-y2.
+				|| rect.x2 > rows_ - 1 || rect.y2 > cols_ - 1 // x2-y2 is exceeds frame.
+				|| tiles_.empty())); // Create() failed.
+		}
+
+
+		// (Run in the context of multiple threads; no syncronization! - SEGMENTS SHOULD NOT OVERLAP!)
+		// Draw segment.
+		// segment is tile col from - to offsets (*relative to the tile col of rect.y1*).
+		void DrawThread(const Frame::Rect& rect, const std::pair<size_t, size_t> segment)
+		{
+			for (size_t tile_col = rect.y1 / kTileCols + segment.first; tile_col <= rect.y1 / kTileCols + segment.second; ++tile_col) {
+				for (size_t tile_row = rect.x1 / kTileRows; tile_row <= rect.x2 / kTileRows; ++tile_row) {
+
+					// The part of rect within the tile (in frame coordinates):
+					const size_t tile_x1{ tile_row * kTileRows }, tile_y1{ tile_col * kTileCols };
+					const size_t tile_x2{ std::min(tile_x1 + kTileRows, rows_) - 1 }, tile_y2{ std::min(tile_y1 + kTileCols, cols_) - 1 };
+					const size_t x1{ std::max(rect.x1, tile_x1) }, x2{ std::min(rect.x2, tile_x2) };
+					const size_t y1{ std::max(rect.y1, tile_y1) }, y2{ std::min(rect.y2, tile_y2) };
+
+					// (Each thread writes to exclusive tiles => No need for mutex.)
+					Tile& tile{ tiles_[GetTileIndex(tile_row, tile_col)] };
+
+					const bool covered{ x1 == tile_x1 && x2 == tile_x2 && y1 == tile_y1 && y2 == tile_y2 };
+					if (covered) { // O(1): solid "White" (0x00). (A snapshot keeps its reference to the chars.)
+						tile.chars.reset();
+						tile.value = 0x00;
+
+						continue;
+					}
+
+					if (tile.chars == nullptr) {
+						if (tile.value == 0x00) { // Already solid "White".
+							continue;
+						}
+
+						// Materialize the solid tile (rect edge):
+						tile.chars = std::shared_ptr<char[]>(new char[kTileRows * kTileCols]);
+						std::memset(tile.chars.get(), tile.value, kTileRows * kTileCols);
+					}
+					else if (tile.chars.use_count() > 1) { // Copy-on-write: the chars are shared with a snapshot.
+						auto chars{ std::shared_ptr<char[]>(new char[kTileRows * kTileCols]) };
+						std::memcpy(chars.get(), tile.chars.get(), kTileRows * kTileCols);
+						tile.chars = std::move(chars);
+					}
+					else {
+						// The count was 1: only this frame holds the chars, and only this frame could share them again.
+						// (Pairs with the release of a snapshot's reference, so its reads happen before our writes.)
+						std::atomic_thread_fence(std::memory_order_acquire);
+					}
+
+					for (size_t y = y1; y <= y2; ++y) {
+						std::span<char> char_span(&tile.chars[(x1 - tile_x1) + (y - tile_y1) * kTileRows], (x2 - x1) + 1);
+						std::ranges::fill(char_span, 0x00); // Draw "White" (0x00).
+					}
+				}
+			}
+		}
+
+
+		// Create a blank frame: a map of solid "Black" tiles.
+		[[nodiscard]] bool Create(const size_t rows, const size_t cols)
+		{
+			// If rows and/or cols 0, return false. tiles_ stays empty.
+			if (!(rows > 0 && cols > 0)) {
+				std::cerr << "error: TiledFrame::Create() rows and/or cols 0." << std::endl;
+
+				return false;
+			}
+
+			try
+			{
+				tile_grid_rows_ = (rows + kTileRows - 1) / kTileRows;
+				tiles_.resize(tile_grid_rows_ * ((cols + kTileCols - 1) / kTileCols));
+				rows_ = rows;
+				cols_ = cols;
+
+				std::cout << "create tiled frame (rows: " << rows << ", cols: " << cols << ", tiles: " << tiles_.size() << ")" << std::endl;
+			}
+			catch ([[maybe_unused]] const std::bad_alloc& e)
+			{
+				// tiles_ stays empty.
+				return false;
+			}
+
+			return true;
+		}
+
+
+		// Return the index of a tile in tiles_ (tile-col major, so a tile col is contiguous).
+		[[nodiscard]] size_t GetTileIndex(const size_t tile_row, const size_t tile_col) const
+		{
+			return tile_row + tile_col * tile_grid_rows_;
+		}
+
+
+		size_t rows_{ 0 }, cols_{ 0 }, tile_grid_rows_{ 0 };
+
+		std::vector<Tile> tiles_{}; // Initially all solid "Black" (0xFF).
+	};
+
+
+	// Let's visually confirm that it is functioning correctly. 
+	static void TestFunctionality()
+	{
+		std::cout << "**** test functionality: small frame + small draw + print frame: ****\n" << std::endl;
+
+		std::vector<std::pair<size_t, size_t>> xy_sets{ { 10, 15 } /* Possible to add here more frames */ };
+		for (const auto& xy : xy_sets)
+		{
+			Frame frame{ xy.first, xy.second };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 3, 2 }) };
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame();
+			std::cout << std::endl;
+
+			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame();
+			std::cout << std::endl;
+		}
+	}
+
+
+	// Let's assess the performance on a very large frame with a different thread count.
+	static void TestPerformance()
+	{
+		std::cout << "**** test performance (hardware concurrency: " << std::thread::hardware_concurrency() << "): large frame + large draw: ****\n" << std::endl;
+
+		PrintThreadBudget();
+		std::cout << std::endl;
+
+		constexpr size_t kFrameRows = 600000;
+		constexpr size_t kFrameCols = 2000;
+
+		// 512MB
+		constexpr size_t kDrawRows = 524288; // 512KB
+		constexpr size_t kDrawCols = 1024; // 1KB
+
+		Frame frame{ kFrameRows, kFrameCols };
+		std::cout << std::endl;
+
+		{
+			size_t buffer_size{ static_cast<size_t>(kDrawRows) * kDrawCols }; // Cast sub-expr. to a wider type.
+
+			std::cout << "benchmark: std::memcpy of " << buffer_size << " bytes" << std::endl;
+
+			auto start_time = Now(); // <-- Start.
+
+			// Benchmark:
+			auto buffer = std::unique_ptr<char[]>(new char[buffer_size]);
+			std::memset(buffer.get(), '0', buffer_size);
+
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << std::endl;
+		}
+
+		[[maybe_unused]] bool ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 1);
+		std::cout << std::endl;
+
+		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 2);
+		std::cout << std::endl;
+
+		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 4);
+		std::cout << std::endl;
+
+		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 8);
+		std::cout << std::endl;
+
+		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, 12);
+		std::cout << std::endl;
+
+		ok = frame.Draw({ 1, 1, kDrawRows, kDrawCols }, GetThreadBudget().budget); // (The thread budget.)
+		std::cout << std::endl;
+	}
+
+
+	// Let's verify the separable blur against a direct reference, then assess it on a large frame.
+	static void TestConvolution()
+	{
+		std::cout << "**** test convolution: small frame blur vs reference + large frame blur: ****\n" << std::endl;
+
+		{
+			constexpr size_t kRows = 37;
+			constexpr size_t kCols = 29;
+			constexpr size_t kRadius = 2;
+
+			Frame src{ kRows, kCols }, dst{ kRows, kCols };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ src.Draw({ 3, 2, 20, 10 }) };
+			ok = src.Draw({ 25, 15, 36, 28 }, 2);
+			std::cout << std::endl;
+
+			const auto kernel{ Frame::GaussianKernel(kRadius, 1.0f) };
+			ok = src.Convolve(dst, kernel, 3);
+			std::cout << std::endl;
+
+			// Reference: the same two passes, computed directly with clamped indices.
+			const float sum{ std::accumulate(kernel.begin(), kernel.end(), 0.0f) };
+			const auto clamp_index = [&](const size_t i, const size_t size) { return std::clamp(i, kRadius, (size - 1) + kRadius) - kRadius; };
+
+			std::vector<unsigned char> h(kRows * kCols);
+			for (size_t y = 0; y < kCols; ++y) {
+				for (size_t x = 0; x < kRows; ++x) {
+					float acc{ 0.0f };
+					for (size_t t = 0; t < kernel.size(); ++t) {
+						acc += (kernel[t] / sum) * static_cast<unsigned char>(src.GetPixel(clamp_index(x + t, kRows), y));
+					}
+					h[x + y * kRows] = static_cast<unsigned char>(std::min(acc + 0.5f, 255.0f));
+				}
+			}
+
+			int max_diff{ 0 };
+			for (size_t y = 0; y < kCols; ++y) {
+				for (size_t x = 0; x < kRows; ++x) {
+					float acc{ 0.0f };
+					for (size_t t = 0; t < kernel.size(); ++t) {
+						acc += (kernel[t] / sum) * h[x + clamp_index(y + t, kCols) * kRows];
+					}
+					const int expected{ static_cast<unsigned char>(std::min(acc + 0.5f, 255.0f)) };
+					max_diff = std::max(max_diff, std::abs(expected - static_cast<unsigned char>(dst.GetPixel(x, y))));
+				}
+			}
+
+			std::cout << "reference check: " << (max_diff <= 1 ? "ok" : "MISMATCH") << " (max diff: " << max_diff << ")" << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			constexpr size_t kFrameRows = 60000;
+			constexpr size_t kFrameCols = 2000;
+
+			Frame src{ kFrameRows, kFrameCols }, dst{ kFrameRows, kFrameCols };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ src.Draw({ 1000, 100, 50000, 1500 }) };
+			std::cout << std::endl;
+
+			const auto kernel{ Frame::GaussianKernel(3, 1.5f) };
+			for (const size_t n : { 1, 2, 4, 8 }) {
+				ok = src.Convolve(dst, kernel, n);
+				std::cout << std::endl;
+			}
+		}
+	}
+
+
+	// Let's verify the tracked histogram against a recount, then assess the statistics bandwidth on a large frame.
+	static void TestStatistics()
+	{
+		std::cout << "**** test statistics: tracked histogram vs recount + large frame histogram / coverage: ****\n" << std::endl;
+
+		{
+			Frame frame{ 10, 15 };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.TrackHistogram() };
+
+			ok = frame.Draw({ 1, 1, 3, 2 });
+			ok = frame.Draw({ 2, 1, 8, 13 }, 2); // (Overlaps the first draw.)
+			std::cout << std::endl;
+
+			Frame::CharHistogram histogram{};
+			ok = frame.ComputeHistogram({ 0, 0, 9, 14 }, histogram, 2);
+
+			const auto* tracked{ frame.GetTrackedHistogram() };
+			std::cout << "tracked histogram: " << ((tracked != nullptr && *tracked == histogram) ? "ok" : "MISMATCH")
+				<< " (white: " << histogram[0x00] << ", black: " << histogram[0xFF] << ")" << std::endl;
+
+			double coverage{ 0.0 };
+			ok = frame.ComputeCoverage({ 0, 0, 9, 14 }, coverage);
+			std::cout << "frame coverage: " << std::format("{:.3f}", coverage) << " (expected: " << std::format("{:.3f}", histogram[0x00] / 150.0) << ")" << std::endl;
+
+			ok = frame.ComputeCoverage({ 2, 1, 8, 13 }, coverage, 3);
+			std::cout << "sub-rect coverage: " << std::format("{:.3f}", coverage) << " (expected: 1.000)" << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			constexpr size_t kFrameRows = 100000;
+			constexpr size_t kFrameCols = 2000;
+
+			Frame frame{ kFrameRows, kFrameCols };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 80000, 1500 }) };
+			std::cout << std::endl;
+
+			for (const size_t n : { 1, 2, 4, 8 }) {
+				double coverage{ 0.0 };
+				ok = frame.ComputeCoverage({ 0, 0, kFrameRows - 1, kFrameCols - 1 }, coverage, n);
+				std::cout << "coverage: " << std::format("{:.3f}", coverage) << std::endl;
+
+				Frame::CharHistogram histogram{};
+				ok = frame.ComputeHistogram({ 0, 0, kFrameRows - 1, kFrameCols - 1 }, histogram, n);
+				std::cout << std::endl;
+			}
+		}
+	}
+
+	// Let's compare the sparse tiled frame to the dense frame: content, then memory and time of create + small and large draws.
+	static void TestTiledFrame()
+	{
+		std::cout << "**** test tiled frame: functionality + memory / time vs dense frame: ****\n" << std::endl;
+
+		{
+			TiledFrame frame{ 10, 15 };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 3, 2 }) };
+			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame();
+			std::cout << std::endl;
+		}
+
+		{
+			// Several tiles: covered (solid), partial and untouched tiles, and a partial draw over a solid tile.
+			constexpr size_t kRows = 3 * TiledFrame::kTileRows + 100;
+			constexpr size_t kCols = 3 * TiledFrame::kTileCols + 10;
+
+			const std::vector<Frame::Rect> rects{ { 0, 0, 2 * TiledFrame::kTileRows + 7, TiledFrame::kTileCols * 2 - 1 }, { 100, 30, 5000, 150 }, { 9000, 70, 12000, kCols - 1 } };
+
+			Frame dense{ kRows, kCols };
+			TiledFrame tiled{ kRows, kCols };
+			for (const auto& rect : rects) {
+				[[maybe_unused]] bool ok{ dense.Draw(rect, 2) };
+				ok = tiled.Draw(rect, 2);
+			}
+
+			size_t mismatches{ 0 };
+			for (size_t y = 0; y < kCols; ++y) {
+				for (size_t x = 0; x < kRows; ++x) {
+					mismatches += (dense.GetPixel(x, y) != tiled.GetPixel(x, y)) ? 1 : 0;
+				}
+			}
+			std::cout << "tiled vs dense check: " << (mismatches == 0 ? "ok" : "MISMATCH") << " (allocated tiles: " << tiled.GetMaterializedTileCount() << " / " << tiled.GetTileCount() << ")" << std::endl;
+			std::cout << std::endl;
+		}
+
+		constexpr size_t kFrameRows = 600000;
+		constexpr size_t kFrameCols = 2000;
+
+		// (The last rect is tile aligned: only solid tiles.)
+		const std::vector<Frame::Rect> rects{ { 1, 1, 1000, 10 }, { 100000, 500, 120000, 600 }, { 1, 1, 524288, 1024 }, { 0, 0, 32 * TiledFrame::kTileRows - 1, 16 * TiledFrame::kTileCols - 1 } };
+
+		{
+			auto start_time = Now(); // <-- Start.
+			Frame frame{ kFrameRows, kFrameCols };
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << "dense frame memory: " << FormatCharCount(kFrameRows * kFrameCols) << " bytes" << std::endl;
+			std::cout << std::endl;
+
+			for (const auto& rect : rects) {
+				[[maybe_unused]] bool ok{ frame.Draw(rect, 4) };
+				std::cout << std::endl;
+			}
+		}
+
+		{
+			auto start_time = Now(); // <-- Start.
+			TiledFrame frame{ kFrameRows, kFrameCols };
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << std::endl;
+
+			for (const auto& rect : rects) {
+				[[maybe_unused]] bool ok{ frame.Draw(rect, 4) };
+				std::cout << "tiled frame memory: " << FormatCharCount(frame.GetMemoryUsage()) << " bytes (tiles: " << frame.GetMaterializedTileCount() << " / " << frame.GetTileCount() << ")" << std::endl;
+				std::cout << std::endl;
+			}
+		}
+	}
+
+
+	// Let's verify that a snapshot stays unchanged, then assess the draw overhead while a snapshot is alive.
+	static void TestSnapshot()
+	{
+		std::cout << "**** test snapshot: copy-on-write snapshot + draw overhead while alive: ****\n" << std::endl;
+
+		{
+			TiledFrame frame{ 10, 15 };
+			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 3, 2 }) };
+			std::cout << std::endl;
+
+			const TiledFrame snapshot{ frame.Snapshot() };
+			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
+			std::cout << std::endl;
+
+			std::cout << "live ";
+			ok = frame.PrintFrame();
+			std::cout << "snapshot ";
+			ok = snapshot.PrintFrame();
+			std::cout << std::endl;
+		}
+
+		constexpr size_t kTileRowCount = 16;
+		constexpr size_t kFrameRows = kTileRowCount * TiledFrame::kTileRows;
+		constexpr size_t kFrameCols = 2048;
+
+		// Partial draws into every tile: 100 rows at offset in each tile row, all the cols.
+		const auto draw_stripes = [&](TiledFrame& frame, const size_t offset) {
+			const auto start_time = Now(); // <-- Start.
+			for (size_t tile_row = 0; tile_row < kTileRowCount; ++tile_row) {
+				const size_t x1{ tile_row * TiledFrame::kTileRows + offset };
+				[[maybe_unused]] bool ok{ frame.Draw({ x1, 0, x1 + 99, kFrameCols - 1 }, 4) };
+			}
+			std::cout << "stripes total ";
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << "(tiles allocated: " << frame.GetMaterializedTileCount() << ", shared: " << frame.GetSharedTileCount() << ")" << std::endl;
+			std::cout << std::endl;
+		};
+
+		TiledFrame frame{ kFrameRows, kFrameCols };
+		std::cout << std::endl;
+
+		draw_stripes(frame, 0); // Materializes every tile.
+		draw_stripes(frame, 200); // No snapshot: plain writes.
+
+		{
+			const TiledFrame snapshot{ frame.Snapshot() };
+			std::cout << std::endl;
+
+			draw_stripes(frame, 400); // Snapshot alive: first write to each tile copies it.
+			draw_stripes(frame, 600); // Snapshot alive: tiles already copied.
+
+			std::cout << "snapshot unchanged: " << (snapshot.GetPixel(400, 0) == static_cast<char>(0xFF) && frame.GetPixel(400, 0) == 0x00 ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+	}
+
+
+	// Let's assess frame create / destroy cycles: plain frames vs pooled frames (per reset mode).
+	static void TestFramePool()
+	{
+		std::cout << "**** test frame pool: create / draw / destroy cycles, plain vs pooled frames: ****\n" << std::endl;
+
+		constexpr size_t kFrameRows = 50000;
+		constexpr size_t kFrameCols = 2000;
+		constexpr size_t kCycles = 6;
+
+		{
+			std::cout << "plain frames:" << std::endl;
+			const auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kCycles; ++i) {
+				Frame frame{ kFrameRows, kFrameCols };
+				[[maybe_unused]] const bool ok{ frame.Draw({ 1, 1, 1000, 1000 }) };
+			}
+			std::cout << "cycles total ";
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << std::endl;
+		}
+
+		const std::vector<std::pair<FramePool::ResetMode, const char*>> modes{ { FramePool::ResetMode::kSerial, "serial reset" },
+			{ FramePool::ResetMode::kParallel, "parallel reset" }, { FramePool::ResetMode::kNone, "no reset" } };
+
+		for (const auto& [mode, name] : modes) {
+			std::cout << "pooled frames (" << name << "):" << std::endl;
+
+			FramePool pool{ mode, 4 };
+			const auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kCycles; ++i) {
+				Frame frame{ pool.Acquire(kFrameRows, kFrameCols) };
+				[[maybe_unused]] const bool ok{ frame.Draw({ 1, 1, 1000, 1000 }) };
+				pool.Release(std::move(frame));
+			}
+			std::cout << "cycles total ";
+			PrintDuration(start_time); // <-- Finish.
+			pool.PrintStats();
+
+			if (mode != FramePool::ResetMode::kNone) { // (A reused frame is blank again.)
+				const Frame frame{ pool.Acquire(kFrameRows, kFrameCols) };
+				std::cout << "reused frame blank: " << (frame.GetPixel(1, 1) == static_cast<char>(0xFF) ? "ok" : "MISMATCH") << std::endl;
+			}
+			std::cout << std::endl;
+		}
+
+		{
+			// Frames not made as the pool makes them are not pooled: borrowed, from another resource, of the other encoding.
+			constexpr size_t kRows = 100, kCols = 50;
+			FramePool pool{};
+			std::vector<char> external(Frame::kDataIndex + kRows * kCols);
+			PageResource pages{};
+
+			pool.Release(Frame::Adopt(Frame::Buffer{ external.data(), BufferDeleter{ nullptr, external.size() } }, kRows, kCols));
+			pool.Release(Frame{ kRows, kCols, &pages });
+			pool.Release(Frame{ kRows, kCols, std::pmr::get_default_resource(), Frame::kDefaultAlignment, Frame::PixelEncoding::kBlackZero });
+			const Frame frame{ pool.Acquire(kRows, kCols) };
+			pool.PrintStats();
+
+			const FramePool::Stats stats{ pool.GetStats() };
+			std::cout << "foreign buffers rejected: " << (stats.rejects == 3 && stats.hits == 0 && frame.GetEncoding() == Frame::PixelEncoding::kWhiteZero ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's assess create + draw of a large frame for each provided memory resource.
+	static void TestMemoryResources()
+	{
+		std::cout << "**** test memory resources: large frame create + draw per memory resource: ****\n" << std::endl;
+
+		constexpr size_t kFrameRows = 100000;
+		constexpr size_t kFrameCols = 2000;
+
+		PageResource pages{}, huge_pages{ PageResource::kHugePages }, locked_pages{ PageResource::kLocked }, shared_pages{ PageResource::kShared };
+
+		// An arena for the frames of one cycle: one upfront allocation, released at once (per-frame deallocate is a no-op).
+		std::pmr::monotonic_buffer_resource arena{ 2 * (kFrameRows * kFrameCols + 4096), &pages };
+
+		struct Resource final
+		{
+			const char* name;
+			std::pmr::memory_resource* resource;
+			size_t alignment;
+		};
+
+		const std::vector<Resource> resources{ { "new / delete", std::pmr::new_delete_resource(), Frame::kDefaultAlignment },
+			{ "new / delete, 4K aligned", std::pmr::new_delete_resource(), 4096 },
+			{ "pages", &pages, 4096 }, { "huge pages", &huge_pages, 4096 }, { "locked pages", &locked_pages, 4096 },
+			{ "shared pages", &shared_pages, 4096 }, { "arena (monotonic, on pages)", &arena, Frame::kDefaultAlignment } };
+
+		for (const auto& resource : resources) {
+			std::cout << "memory resource: " << resource.name << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+			Frame frame{ kFrameRows, kFrameCols, resource.resource, resource.alignment };
+			std::cout << "create ";
+			PrintDuration(start_time); // <-- Finish.
+
+			[[maybe_unused]] const bool ok{ frame.Draw({ 0, 0, kFrameRows - 1, kFrameCols - 1 }, 4) };
+			std::cout << std::endl;
+		}
+	}
+
+
+	// Let's pass a frame through pipeline stages and verify that its buffer is never copied nor reallocated.
+	static void TestHandoff()
+	{
+		std::cout << "**** test handoff: move / release / adopt through pipeline stages + external buffer: ****\n" << std::endl;
+
+		Frame frame{ 10, 15 };
+		const char* data{ frame.ConstView().GetData() };
+
+		// Stage 1 (draw) -> stage 2 (statistics) -> stage 3 (print), each taking ownership:
+		const auto stage_draw = [](Frame frame) { [[maybe_unused]] const bool ok{ frame.Draw({ 1, 1, 3, 2 }) }; return frame; };
+		const auto stage_count = [](Frame frame) {
+			const ConstFrameView view{ frame.ConstView() };
+			size_t white{ 0 };
+			for (size_t y = 0; y < view.GetCols(); ++y) {
+				for (size_t x = 0; x < view.GetRows(); ++x) {
+					white += (view.At(x, y) == 0x00) ? 1 : 0;
+				}
+			}
+			std::cout << "white chars: " << white << std::endl;
+			return frame;
+		};
+
+		Frame done{ stage_count(stage_draw(std::move(frame))) };
+		std::cout << "moved through stages: " << (done.ConstView().GetData() == data && frame.ConstView().IsEmpty() ? "ok (same buffer)" : "MISMATCH") << std::endl;
+
+		// Release / adopt (e.g. across an API that deals in raw buffers):
+		Frame::Buffer buffer{ done.Release() };
+		const Frame adopted{ Frame::Adopt(std::move(buffer)) };
+		std::cout << "release / adopt: " << (adopted.ConstView().GetData() == data && adopted.GetPixel(1, 1) == 0x00 ? "ok (same buffer)" : "MISMATCH") << std::endl;
+
+		// External memory, borrowed (no resource: the vector keeps owning it):
+		constexpr size_t kRows = 8, kCols = 4;
+		std::vector<char> external(Frame::kDataIndex + kRows * kCols, static_cast<char>(0xFF));
+		{
+			const Frame borrowed{ Frame::Adopt(Frame::Buffer{ external.data(), BufferDeleter{ nullptr, external.size() } }, kRows, kCols) };
+			[[maybe_unused]] const bool ok{ borrowed.Draw({ 2, 1, 5, 2 }) };
+		}
+		std::cout << "external buffer drawn in place: " << (external[Frame::kDataIndex + 2 + 1 * kRows] == 0x00 && external[Frame::kDataIndex + 1 + 1 * kRows] == static_cast<char>(0xFF) ? "ok" : "MISMATCH") << std::endl;
+	}
+
+
+	// Let's hand sub-views of a frame to "subsystems": draw into a sub-view and iterate its cols as spans.
+	static void TestFrameView()
+	{
+		std::cout << "**** test frame view: sub-view draw + col spans: ****\n" << std::endl;
+
+		Frame frame{ 10, 15 };
+		std::cout << std::endl;
+
+		// The same draws as TestFunctionality(), through sub-views:
+		const FrameView view{ frame.View() };
+		[[maybe_unused]] bool ok{ Frame::DrawView(view.SubView({ 1, 1, 3, 2 })) };
+		ok = Frame::DrawView(view.SubView({ 5, 1, 8, 13 }), 2);
+		std::cout << std::endl;
+
+		ok = frame.PrintFrame();
+		std::cout << std::endl;
+
+		// A sub-view of a sub-view keeps the frame stride:
+		const ConstFrameView sub{ frame.ConstView().SubView({ 4, 0, 9, 14 }).SubView({ 1, 1, 4, 13 }) }; // (= frame rect 5-1 - 8-14.)
+		size_t white{ 0 };
+		for (std::span<const char> col : sub.Cols()) {
+			white += static_cast<size_t>(std::ranges::count(col, 0x00));
+		}
+		std::cout << "sub-view (rows: " << sub.GetRows() << ", cols: " << sub.GetCols() << ", stride: " << sub.GetStride() << ") white chars: " << white
+			<< (white == 4 * 13 ? " (ok)" : " (MISMATCH)") << std::endl;
+	}
+
+
+	// Let's verify the fixed-dimension frame, then assess it against the dynamic frame.
+	static void TestFixedFrame()
+	{
+		std::cout << "**** test fixed frame: functionality + compile-time vs dynamic draws: ****\n" << std::endl;
+
+		{
+			const FixedFrame<10, 15> frame{};
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.Draw<FrameRect{ 1, 1, 3, 2 }>() };
+			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame();
+			std::cout << std::endl;
+		}
+
+		{
+			// Large draw: the same rect as TestPerformance().
+			constexpr size_t kFrameRows = 600000;
+			constexpr size_t kFrameCols = 2000;
+
+			{
+				const Frame frame{ kFrameRows, kFrameCols };
+				[[maybe_unused]] const bool ok{ frame.Draw({ 1, 1, 524288, 1024 }, 4) };
+				std::cout << std::endl;
+			}
+			{
+				const FixedFrame<kFrameRows, kFrameCols> frame{};
+				[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 524288, 1024 }, 4) };
+
+				const auto start_time = Now(); // <-- Start.
+				ok = frame.Draw<FrameRect{ 1, 1, 524288, 1024 }>();
+				std::cout << "fixed draw<rect> (main-thread) ";
+				PrintDuration(start_time); // <-- Finish.
+				std::cout << std::endl;
+			}
+		}
+
+		{
+			// Many small draws (e.g. UI widgets) into a fixed-resolution output: the dynamic kernel (sub-view, run-time
+			// extents) vs the compile-time kernel.
+			constexpr size_t kFrameRows = 1080;
+			constexpr size_t kFrameCols = 1920;
+			constexpr size_t kIterations = 200000;
+			constexpr FrameRect kRect{ 100, 200, 131, 215 }; // 32 x 16.
+
+			const Frame dynamic{ kFrameRows, kFrameCols };
+			const FixedFrame<kFrameRows, kFrameCols> fixed{};
+			std::cout << std::endl;
+
+			auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				for (std::span<char> col : dynamic.View().SubView(kRect).Cols()) {
+					std::ranges::fill(col, 0x00);
+				}
+				std::atomic_signal_fence(std::memory_order_seq_cst); // (Keep each iteration's stores.)
+			}
+			std::cout << "dynamic frame: " << kIterations << " draws of 32 x 16 ";
+			PrintDuration(start_time); // <-- Finish.
+
+			start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				[[maybe_unused]] const bool ok{ fixed.Draw<kRect>() };
+				std::atomic_signal_fence(std::memory_order_seq_cst); // (Keep each iteration's stores.)
+			}
+			std::cout << "fixed frame: " << kIterations << " draws of 32 x 16 ";
+			PrintDuration(start_time); // <-- Finish.
+		}
+	}
+
+
+	// Let's verify compiled draw plans against Draw(), then assess the per-call overhead they save on small rects.
+	static void TestDrawPlan()
+	{
+		std::cout << "**** test draw plan: batch plan vs draw + small rect overhead: ****\n" << std::endl;
+
+		{
+			const std::array<FrameRect, 3> rects{ { { 1, 1, 3, 2 }, { 5, 1, 8, 13 }, { 0, 12, 9, 14 } } }; // (Overlapping; whole cols.)
+
+			const Frame drawn{ 10, 15 }, planned{ 10, 15 };
+			for (const FrameRect& rect : rects) {
+				[[maybe_unused]] const bool ok{ drawn.Draw(rect) };
+			}
+			std::cout << std::endl;
+
+			const DrawPlan plan{ DrawPlan::Compile(planned, rects, 4) };
+			plan.Execute();
+			plan.Execute(); // (Idempotent.)
+
+			[[maybe_unused]] const bool ok{ planned.PrintFrame() };
+
+			const bool equal{ std::ranges::equal(drawn.ConstView().Span(), planned.ConstView().Span()) };
+			std::cout << "plan (rects: " << plan.GetRectCount() << ", threads: " << plan.GetThreadCount() << ") vs draw: " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+			const DrawPlan bad{ DrawPlan::Compile(planned, FrameRect{ 0, 0, 10, 0 }) }; // (Beyond the frame.)
+			std::cout << "out-of-frame rect -> empty plan: " << (bad.IsEmpty() ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// A small rect drawn many times (e.g. a UI widget): the draw output is muted, its formatting still runs.
+			constexpr size_t kIterations = 10000;
+			constexpr FrameRect kRect{ 100, 200, 131, 215 }; // 32 x 16.
+
+			const Frame frame{ 1080, 1920 };
+			std::cout << std::endl;
+
+			auto* const cout_buffer{ std::cout.rdbuf(nullptr) }; // Mute.
+			auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				[[maybe_unused]] const bool ok{ frame.Draw(kRect) };
+			}
+			const auto draw_duration{ Now() - start_time }; // <-- Finish.
+			std::cout.rdbuf(cout_buffer); // Unmute.
+			std::cout.clear();
+
+			std::cout << "draw: " << kIterations << " draws of 32 x 16 (execution time: "
+				<< std::chrono::duration_cast<std::chrono::microseconds>(draw_duration).count() << " microseconds)" << std::endl;
+
+			const DrawPlan plan{ DrawPlan::Compile(frame, kRect) };
+			start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				plan.Execute();
+				std::atomic_signal_fence(std::memory_order_seq_cst); // (Keep each iteration's stores.)
+			}
+			std::cout << "plan: " << kIterations << " executions of 32 x 16 (execution time: "
+				<< std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_time).count() << " microseconds)" << std::endl; // <-- Finish.
+		}
+	}
+
+
+	// Let's verify concurrent producers feeding the draw queue against sequential draws, then assess its throughput.
+	static void TestDrawQueue()
+	{
+		std::cout << "**** test draw queue: concurrent producers + consumer pool: ****\n" << std::endl;
+
+		{
+			const Frame drawn{ 10, 15 }, queued{ 10, 15 };
+			[[maybe_unused]] bool ok{ drawn.Draw({ 1, 1, 3, 2 }) };
+			ok = drawn.Draw({ 5, 1, 8, 13 });
+			std::cout << std::endl;
+
+			{
+				DrawQueue queue{ queued, 3 };
+				std::jthread producer{ [&queue]() { [[maybe_unused]] const bool ok{ queue.Submit({ 1, 1, 3, 2 }) }; } };
+				ok = queue.Submit({ 5, 1, 8, 13 });
+				producer.join();
+				queue.Flush();
+				queue.PrintStats();
+			}
+
+			ok = queued.PrintFrame();
+
+			const bool equal{ std::ranges::equal(drawn.ConstView().Span(), queued.ConstView().Span()) };
+			std::cout << "queue vs draw: " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+			// The frame moved away (handed off) while the queue exists: the queue draws into its buffer.
+			Frame moved{ 10, 15 };
+			std::vector<Frame> handed_off; // (Outlives the queue.)
+			{
+				DrawQueue queue{ moved, 2 };
+				handed_off.push_back(std::move(moved));
+				ok = queue.Submit({ 1, 1, 3, 2 });
+				ok = queue.Submit({ 5, 1, 8, 13 });
+				queue.Flush();
+			}
+			const bool same{ std::ranges::equal(drawn.ConstView().Span(), handed_off.front().ConstView().Span()) };
+			std::cout << "queue into a moved frame: " << (same ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// Producers submit many small rects (e.g. UI widgets / sprites) at the same time:
+			constexpr size_t kRows = 1080, kCols = 1920;
+			constexpr size_t kProducers = 4, kCommandsPerProducer = 50000;
+
+			// The rects of a producer (deterministic; 1 - 64 x 1 - 64):
+			const auto make_rects = [](const size_t producer) {
+				std::vector<FrameRect> rects(kCommandsPerProducer);
+				uint64_t state{ 0x9E3779B97F4A7C15ull * (producer + 1) };
+				for (auto& rect : rects) {
+					state = state * 6364136223846793005ull + 1442695040888963407ull; // (LCG.)
+					const size_t x1{ (state >> 16) % (kRows - 64) }, y1{ (state >> 40) % (kCols - 64) };
+					rect = { x1, y1, x1 + ((state >> 8) & 63), y1 + ((state >> 2) & 63) };
+				}
+				return rects;
+			};
+
+			std::vector<std::vector<FrameRect>> rects;
+			for (size_t p = 0; p < kProducers; ++p) {
+				rects.push_back(make_rects(p));
+			}
+
+			const Frame drawn{ kRows, kCols }, queued{ kRows, kCols };
+			for (const auto& producer_rects : rects) {
+				for (const FrameRect& rect : producer_rects) {
+					for (std::span<char> col : drawn.View().SubView(rect).Cols()) {
+						std::ranges::fill(col, 0x00);
+					}
+				}
+			}
+
+			DrawQueue queue{ queued, 4, 4096 };
+			std::cout << std::endl;
+
+			const auto start_time = Now(); // <-- Start.
+			{
+				std::vector<std::jthread> producers;
+				for (size_t p = 0; p < kProducers; ++p) {
+					producers.emplace_back([&queue, &producer_rects = rects[p]]() {
+						for (const FrameRect& rect : producer_rects) {
+							[[maybe_unused]] const bool ok{ queue.Submit(rect) };
+						}
+					});
+				}
+			} // (Producers join here.)
+			queue.Flush();
+			const auto duration_us{ std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_time) }; // <-- Finish.
+
+			queue.PrintStats();
+			const double commands_per_s{ duration_us.count() > 0 ? kProducers * kCommandsPerProducer * 1e6 / duration_us.count() : 0.0 };
+			std::cout << "throughput: " << std::format("{:.0f}", commands_per_s) << " commands/s (execution time: " << duration_us.count() / 1000 << " milliseconds)" << std::endl;
+
+			const bool equal{ std::ranges::equal(drawn.ConstView().Span(), queued.ConstView().Span()) };
+			std::cout << "queue vs sequential draws: " << (equal ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's run a 120 Hz schedule that is overloaded by normal / low priority draws: high priority draws must all be drawn.
+	static void TestFrameScheduler()
+	{
+		std::cout << "**** test frame scheduler: 120 Hz epochs + shedding / deferral: ****\n" << std::endl;
+
+		constexpr size_t kRows = 4096, kCols = 4096;
+		constexpr size_t kEpochs = 6, kHighPerEpoch = 8, kLargePerEpoch = 4;
+
+		const Frame frame{ kRows, kCols };
+		std::cout << std::endl;
+
+		// High priority: small rects in cols 3072 - 4095 (a distinct rect per epoch and draw).
+		// Normal / low priority: large rects in cols 0 - 3071 (12M chars each: more per epoch than a tick allows).
+		const auto high_rect = [](const size_t epoch, const size_t i) {
+			const size_t x1{ (epoch * kHighPerEpoch + i) * 64 };
+			return FrameRect{ x1, 3072, x1 + 31, 3072 + 31 };
+		};
+
+		FrameScheduler scheduler{ frame, std::chrono::microseconds{ 8333 }, 4 };
+		scheduler.RunEpochs(kEpochs, [&](const size_t epoch) {
+			for (size_t i = 0; i < kHighPerEpoch; ++i) {
+				[[maybe_unused]] const bool ok{ scheduler.Submit(high_rect(epoch, i), FrameScheduler::Priority::kHigh) };
+			}
+			for (size_t i = 0; i < kLargePerEpoch; ++i) {
+				[[maybe_unused]] bool ok{ scheduler.Submit({ 0, 0, kRows - 1, 3071 }, FrameScheduler::Priority::kNormal) };
+				ok = scheduler.Submit({ 0, 0, kRows - 1, 3071 }, FrameScheduler::Priority::kLow);
+			}
+		});
+
+		scheduler.PrintStats();
+
+		size_t drawn{ 0 }, shed{ 0 };
+		for (const auto& stats : scheduler.GetEpochStats()) {
+			drawn += stats.drawn;
+			shed += stats.shed;
+		}
+		const size_t submitted{ kEpochs * (kHighPerEpoch + 2 * kLargePerEpoch) };
+		std::cout << "submitted: " << submitted << " = drawn: " << drawn << " + shed: " << shed << " + pending: " << scheduler.GetPendingCount()
+			<< ((drawn + shed + scheduler.GetPendingCount() == submitted) ? " (ok)" : " (MISMATCH)") << std::endl;
+
+		bool high_drawn{ true };
+		for (size_t epoch = 0; epoch < kEpochs; ++epoch) {
+			for (size_t i = 0; i < kHighPerEpoch; ++i) {
+				const FrameRect rect{ high_rect(epoch, i) };
+				high_drawn = high_drawn && frame.GetPixel(rect.x1, rect.y1) == 0x00 && frame.GetPixel(rect.x2, rect.y2) == 0x00;
+			}
+		}
+		std::cout << "high priority draws: " << (high_drawn ? "all drawn (ok)" : "MISMATCH") << std::endl;
+	}
+
+
+	// Let's verify overdraw elimination (stacked, overlapping rects), then assess the time it saves.
+	static void TestOverdraw()
+	{
+		std::cout << "**** test overdraw elimination: stacked rects batch: ****\n" << std::endl;
+
+		{
+			// Disjoint, and the same chars:
+			const std::array<FrameRect, 4> rects{ { { 0, 0, 7, 9 }, { 2, 2, 5, 5 }, { 4, 4, 9, 14 }, { 0, 8, 9, 8 } } };
+			const std::vector<FrameRect> disjoint{ DrawPlan::SubtractOverdraw(rects) };
+
+			std::array<std::array<int, 15>, 10> coverage{}, disjoint_coverage{};
+			for (const FrameRect& rect : rects) {
+				for (size_t x = rect.x1; x <= rect.x2; ++x) for (size_t y = rect.y1; y <= rect.y2; ++y) coverage[x][y] = 1;
+			}
+			for (const FrameRect& rect : disjoint) {
+				for (size_t x = rect.x1; x <= rect.x2; ++x) for (size_t y = rect.y1; y <= rect.y2; ++y) ++disjoint_coverage[x][y];
+			}
+			std::cout << "subtract overdraw (rects: " << rects.size() << " -> " << disjoint.size() << "): "
+				<< (coverage == disjoint_coverage ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// Stacked windows: each later rect covers much of the earlier ones.
+			constexpr size_t kRows = 4096, kCols = 4096, kRects = 16, kIterations = 20;
+
+			std::vector<FrameRect> rects;
+			for (size_t i = 0; i < kRects; ++i) {
+				rects.push_back({ i * 64, i * 64, kRows - 1 - i * 32, kCols - 1 - i * 32 });
+			}
+
+			const Frame overdrawn{ kRows, kCols }, eliminated{ kRows, kCols };
+			std::cout << std::endl;
+
+			const DrawPlan plan{ DrawPlan::Compile(overdrawn, rects, 4) };
+			const DrawPlan eliminated_plan{ DrawPlan::Compile(eliminated, rects, 4, true) };
+
+			std::cout << "batch (rects: " << rects.size() << " -> " << DrawPlan::SubtractOverdraw(rects).size() << " disjoint, requested: " << FormatCharCount(eliminated_plan.GetRequestedChars())
+				<< " chars, written: " << FormatCharCount(eliminated_plan.GetChars()) << " chars, overdraw ratio: " << std::format("{:.2f}", eliminated_plan.GetOverdrawRatio()) << ")" << std::endl;
+
+			auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				plan.Execute();
+			}
+			const auto overdrawn_duration{ Now() - start_time }; // <-- Finish.
+
+			start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kIterations; ++i) {
+				eliminated_plan.Execute();
+			}
+			const auto eliminated_duration{ Now() - start_time }; // <-- Finish.
+
+			const auto to_ms = [](const auto duration) { return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(); };
+			std::cout << kIterations << " executions: with overdraw: " << to_ms(overdrawn_duration) << " milliseconds, without: " << to_ms(eliminated_duration)
+				<< " milliseconds (saved: " << to_ms(overdrawn_duration - eliminated_duration) << " milliseconds)" << std::endl;
+
+			const bool equal{ std::ranges::equal(overdrawn.ConstView().Span(), eliminated.ConstView().Span()) };
+			std::cout << "without overdraw vs with: " << (equal ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify an optimized display list against the recorded draws, then assess replaying it on many frames.
+	static void TestDisplayList()
+	{
+		std::cout << "**** test display list: record + optimize + replay: ****\n" << std::endl;
+
+		{
+			DisplayList list{};
+			[[maybe_unused]] bool ok{ list.Record({ 1, 1, 3, 2 }) };
+			ok = list.Record({ 5, 1, 8, 6 });
+			ok = list.Record({ 5, 7, 8, 13 }); // (Adjacent cols of the same rows: merged.)
+			ok = list.Record({ 6, 3, 7, 9 }); // (Occluded: dropped.)
+			ok = list.Record({ 1, 1, 3, 2 }); // (Duplicate: dropped.)
+
+			const Frame drawn{ 10, 15 }, replayed{ 10, 15 };
+			for (const FrameRect& rect : list.GetRects()) {
+				ok = drawn.Draw(rect);
+			}
+			std::cout << std::endl;
+
+			list.Optimize();
+			ok = list.Replay(replayed, 2);
+			ok = replayed.PrintFrame();
+
+			const bool equal{ std::ranges::equal(drawn.ConstView().Span(), replayed.ConstView().Span()) };
+			std::cout << "replay (rects: " << list.GetRects().size() << ") vs draw: " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+			DisplayList empty{};
+			empty.Optimize();
+			std::cout << "optimize empty list: " << (empty.GetRects().empty() && empty.GetChars() == 0 ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// A UI of 16 x 16 cells recorded row by row (across the cols: poor locality), each cell twice (a background and
+			// a highlight inside it), replayed on kFrames frames:
+			constexpr size_t kRows = 2048, kCols = 2048, kCell = 128, kFrames = 8;
+
+			DisplayList list{};
+			for (size_t x = 0; x < kRows; x += kCell) {
+				for (size_t y = 0; y < kCols; y += kCell) {
+					[[maybe_unused]] bool ok{ list.Record({ x, y, x + kCell - 1, y + kCell - 1 }) };
+					ok = list.Record({ x + 8, y + 8, x + kCell - 9, y + kCell - 9 });
+				}
+			}
+			DisplayList optimized{ list };
+			optimized.Optimize();
+
+			std::vector<Frame> frames;
+			for (size_t i = 0; i < kFrames; ++i) {
+				frames.emplace_back(kRows, kCols);
+			}
+			std::cout << std::endl;
+
+			auto start_time = Now(); // <-- Start.
+			for (const Frame& frame : frames) {
+				[[maybe_unused]] const bool ok{ list.Replay(frame, 4) };
+			}
+			std::cout << "replay as recorded (rects: " << list.GetRects().size() << ") on " << kFrames << " frames ";
+			PrintDuration(start_time); // <-- Finish.
+
+			for (const Frame& frame : frames) {
+				[[maybe_unused]] const bool ok{ frame.Reset() };
+			}
+			std::cout << std::endl;
+
+			start_time = Now(); // <-- Start.
+			for (const Frame& frame : frames) {
+				[[maybe_unused]] const bool ok{ optimized.Replay(frame, 4) };
+			}
+			std::cout << "replay optimized (rects: " << optimized.GetRects().size() << ") on " << kFrames << " frames ";
+			PrintDuration(start_time); // <-- Finish.
+
+			bool equal{ true };
+			for (const Frame& frame : frames) {
+				equal = equal && std::ranges::all_of(frame.ConstView().Span(), [](const char c) { return c == 0x00; });
+			}
+			std::cout << "optimized replays (whole frames drawn): " << (equal ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify tile composition against naive back-to-front drawing, then assess the occlusion culling.
+	static void TestCompositor()
+	{
+		std::cout << "**** test compositor: layers + occlusion culling vs naive back-to-front: ****\n" << std::endl;
+
+		{
+			const Frame source{ 3, 4 };
+			[[maybe_unused]] bool ok{ source.Draw({ 1, 1, 1, 2 }) };
+
+			Compositor compositor{};
+			compositor.AddRectLayer({ { 0, 0, 9, 14 } }, 0x00); // (Background.)
+			compositor.AddRectLayer({ { 1, 1, 3, 2 }, { 5, 1, 8, 13 } }, static_cast<char>(0xFF));
+			compositor.AddFrameLayer(source.ConstView(), 6, 9);
+
+			const Frame composed{ 10, 15 }, naive{ 10, 15 };
+			std::cout << std::endl;
+
+			ok = compositor.Compose(composed);
+			ok = compositor.ComposeNaive(naive);
+			ok = composed.PrintFrame();
+
+			const bool equal{ std::ranges::equal(composed.ConstView().Span(), naive.ConstView().Span()) };
+			std::cout << "compose vs naive: " << (equal ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// A desktop: a background, 6 stacked windows, and a video on top covering most of the screen.
+			constexpr size_t kRows = 4096, kCols = 4096;
+
+			const Frame video{ 3584, 3584 };
+			[[maybe_unused]] bool ok{ video.Draw({ 0, 0, 1791, 3583 }) };
+
+			Compositor compositor{};
+			compositor.AddRectLayer({ { 0, 0, kRows - 1, kCols - 1 } }, 0x10);
+			for (size_t i = 0; i < 6; ++i) {
+				compositor.AddRectLayer({ { i * 256, i * 256, i * 256 + 2047, i * 256 + 2047 } }, static_cast<char>(0x20 + i));
+			}
+			compositor.AddFrameLayer(video.ConstView(), 256, 256);
+
+			const Frame composed{ kRows, kCols }, naive{ kRows, kCols };
+			std::cout << std::endl;
+
+			ok = compositor.ComposeNaive(naive, 4);
+			std::cout << std::endl;
+			ok = compositor.Compose(composed, 4);
+
+			const bool equal{ std::ranges::equal(composed.ConstView().Span(), naive.ConstView().Span()) };
+			std::cout << "compose vs naive: " << (equal ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify clipping (to the frame and to nested clip regions), then assess heavily clipped draws against
+	// clipping by hand.
+	static void TestClip()
+	{
+		std::cout << "**** test clip: clip stack + clipping to the frame: ****\n" << std::endl;
+
+		{
+			Frame frame{ 10, 15 };
+			[[maybe_unused]] bool ok{ frame.TrackHistogram() };
+			std::cout << std::endl;
+
+			const std::array<FrameRect, 2> clip_union{ { { 0, 0, 4, 4 }, { 3, 3, 9, 6 } } }; // (Overlapping.)
+			const FrameRect clip{ 2, 0, 9, 14 };
+			const FrameRect rect{ 1, 1, 30, 30 }; // (Beyond the frame.)
+
+			ok = frame.PushClip(clip_union);
+			ok = frame.PushClip(clip);
+			ok = frame.Draw(rect, 2);
+			ok = frame.PopClip();
+			ok = frame.PopClip();
+			ok = frame.Draw({ 0, 13, 20, 13 }); // (Clipped to the frame only.)
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame();
+
+			const auto inside = [](const FrameRect& r, const size_t x, const size_t y) { return r.x1 <= x && x <= r.x2 && r.y1 <= y && y <= r.y2; };
+			bool expected{ true };
+			for (size_t x = 0; x < 10; ++x) {
+				for (size_t y = 0; y < 15; ++y) {
+					const bool white{ (inside(rect, x, y) && inside(clip, x, y) && (inside(clip_union[0], x, y) || inside(clip_union[1], x, y))) || y == 13 };
+					expected = expected && (frame.GetPixel(x, y) == 0x00) == white;
+				}
+			}
+			std::cout << "clipped draws: " << (expected ? "ok" : "MISMATCH") << std::endl;
+
+			Frame::CharHistogram histogram{};
+			ok = frame.ComputeHistogram({ 0, 0, 9, 14 }, histogram);
+			std::cout << "tracked histogram of clipped draws: " << (histogram == *frame.GetTrackedHistogram() ? "ok" : "MISMATCH") << std::endl;
+
+			std::cout << "pop empty clip stack: " << (!frame.PopClip() ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+
+			// "Everything" rects (their extents overflow): clipped to the frame.
+			const Frame everything{ 10, 15 }, whole{ 10, 15 };
+			ok = everything.Draw({ 0, 0, std::numeric_limits<size_t>::max(), 0 });
+			ok = everything.Draw({ 0, 0, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max() }, 2) && ok;
+			ok = whole.Draw({ 0, 0, 9, 14 }) && ok;
+			std::cout << "everything rect: " << (ok && std::ranges::equal(everything.ConstView().Span(), whole.ConstView().Span()) ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// Windows (a 16 x 16 grid of 128 x 128 rects) clip a few large draws:
+			constexpr size_t kRows = 4096, kCols = 4096, kDraws = 16;
+
+			std::vector<FrameRect> windows;
+			for (size_t x = 0; x < kRows; x += 256) {
+				for (size_t y = 0; y < kCols; y += 256) {
+					windows.push_back({ x, y, x + 127, y + 127 });
+				}
+			}
+
+			Frame clipped{ kRows, kCols };
+			const Frame by_hand{ kRows, kCols };
+			[[maybe_unused]] bool ok{ clipped.PushClip(windows) };
+			std::cout << std::endl;
+
+			auto* const cout_buffer{ std::cout.rdbuf(nullptr) }; // Mute.
+
+			auto start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kDraws; ++i) {
+				ok = clipped.Draw({ i * 64, i * 128, kRows - 1 - i * 32, kCols - 1 }, 4);
+			}
+			const auto clipped_duration{ Now() - start_time }; // <-- Finish.
+
+			start_time = Now(); // <-- Start.
+			for (size_t i = 0; i < kDraws; ++i) {
+				const FrameRect rect{ i * 64, i * 128, kRows - 1 - i * 32, kCols - 1 };
+				for (const FrameRect& window : windows) {
+					FrameRect piece{};
+					if (IntersectRects(rect, window, piece)) {
+						ok = by_hand.Draw(piece, 4);
+					}
+				}
+			}
+			const auto by_hand_duration{ Now() - start_time }; // <-- Finish.
+
+			std::cout.rdbuf(cout_buffer); // Unmute.
+			std::cout.clear();
+
+			const auto to_ms = [](const auto duration) { return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(); };
+			std::cout << kDraws << " draws clipped by " << windows.size() << " windows: clip region: " << to_ms(clipped_duration)
+				<< " milliseconds, by hand (a draw per window): " << to_ms(by_hand_duration) << " milliseconds" << std::endl;
+
+			const bool equal{ std::ranges::equal(clipped.ConstView().Span(), by_hand.ConstView().Span()) };
+			std::cout << "clip region vs by hand: " << (equal ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify the pixel encodings, then assess resetting a page-backed frame by giving its pages back to the OS.
+	static void TestZeroPageReset()
+	{
+		std::cout << "**** test zero page reset: pixel encoding + page discard: ****\n" << std::endl;
+
+		{
+			const Frame frame{ 10, 15, std::pmr::get_default_resource(), Frame::kDefaultAlignment, Frame::PixelEncoding::kBlackZero };
+			std::cout << std::endl;
+
+			[[maybe_unused]] bool ok{ frame.Draw({ 1, 1, 3, 2 }) };
+			ok = frame.Draw({ 5, 1, 8, 13 }, 2);
+			std::cout << std::endl;
+
+			ok = frame.PrintFrame(); // (The same as TestFunctionality(): "White" is printed as 0.)
+
+			const bool chars{ frame.GetPixel(1, 1) == static_cast<char>(0xFF) && frame.GetPixel(0, 0) == 0x00 };
+			std::cout << "black zero chars (white: 0xFF, black: 0x00): " << (chars ? "ok" : "MISMATCH") << std::endl;
+
+			ok = frame.Reset();
+			const bool blank{ std::ranges::all_of(frame.ConstView().Span(), [](const char c) { return c == 0x00; }) };
+			std::cout << "reset to zero: " << (blank ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// A large page-backed frame with a few small draws per use (e.g. sparse overlays), reset between uses:
+			constexpr size_t kRows = 16384, kCols = 8192; // 128M chars.
+
+			PageResource pages{};
+
+			auto start_time = Now(); // <-- Start.
+			const Frame frame{ kRows, kCols, &pages, Frame::kDefaultAlignment, Frame::PixelEncoding::kBlackZero };
+			std::cout << "create (zero pages: no initialization) ";
+			PrintDuration(start_time); // <-- Finish.
+
+			std::vector<FrameRect> rects;
+			for (size_t i = 0; i < 64; ++i) {
+				const size_t x{ (i * 2654435761u) % (kRows - 32) }, y{ (i * 40503u) % (kCols - 32) };
+				rects.push_back({ x, y, x + 31, y + 31 });
+			}
+			const DrawPlan plan{ DrawPlan::Compile(frame, rects) };
+			std::cout << std::endl;
+
+			plan.Execute();
+			start_time = Now(); // <-- Start.
+			[[maybe_unused]] bool ok{ frame.Reset(4, false) };
+			std::cout << "reset by writing every char (" << FormatCharCount(kRows * kCols) << " chars) ";
+			PrintDuration(start_time); // <-- Finish.
+
+			plan.Execute();
+			start_time = Now(); // <-- Start.
+			ok = frame.Reset(4);
+			std::cout << "reset by discarding the pages ";
+			PrintDuration(start_time); // <-- Finish.
+
+			start_time = Now(); // <-- Start.
+			plan.Execute();
+			std::cout << "sparse draws after the discard (" << rects.size() << " rects) ";
+			PrintDuration(start_time); // <-- Finish.
+			std::cout << std::endl;
+
+			ok = frame.Reset(4);
+			double coverage{ 1.0 };
+			ok = frame.ComputeCoverage({ 0, 0, kRows - 1, kCols - 1 }, coverage, 4);
+			std::cout << "blank after discard: " << (coverage == 0.0 ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify lazy frames against eager ones, then assess creating and drawing the large frame of TestPerformance().
+	static void TestLazyFrame()
+	{
+		std::cout << "**** test lazy frame: per col initialization on first access: ****\n" << std::endl;
+
+		{
+			const Frame eager{ 10, 15 };
+			Frame lazy{ Frame::Lazy(10, 15) };
+			[[maybe_unused]] bool ok{ lazy.TrackHistogram() };
+			std::cout << std::endl;
+
+			for (const Frame* frame : std::array<const Frame*, 2>{ &eager, &lazy }) {
+				ok = frame->Draw({ 1, 1, 3, 2 });
+				ok = frame->Draw({ 5, 1, 8, 13 }, 2);
+				ok = frame->Draw({ 0, 14, 9, 14 }); // (A whole col.)
+			}
+			std::cout << std::endl;
+
+			const bool pixel{ lazy.GetPixel(0, 0) == eager.GetPixel(0, 0) && lazy.GetPixel(9, 14) == eager.GetPixel(9, 14) };
+			std::cout << "lazy vs eager pixels: " << (pixel ? "ok" : "MISMATCH") << std::endl;
+
+			const bool equal{ std::ranges::equal(eager.ConstView().Span(), lazy.ConstView().Span()) };
+			std::cout << "lazy vs eager frame: " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+			Frame::CharHistogram histogram{};
+			ok = lazy.ComputeHistogram({ 0, 0, 9, 14 }, histogram);
+			std::cout << "lazy tracked histogram: " << (histogram == *lazy.GetTrackedHistogram() ? "ok" : "MISMATCH") << std::endl;
+
+			ok = lazy.Reset();
+			std::cout << "lazy reset: " << (lazy.GetPixel(1, 1) == lazy.GetBlack() && std::ranges::all_of(lazy.ConstView().Span(), [&](const char c) { return c == lazy.GetBlack(); }) ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			// The frame of TestPerformance(): create, then draw it whole.
+			constexpr size_t kFrameRows = 600000;
+			constexpr size_t kFrameCols = 2000;
+
+			for (const bool lazy : { false, true }) {
+				auto start_time = Now(); // <-- Start.
+				const Frame frame{ lazy ? Frame::Lazy(kFrameRows, kFrameCols) : Frame{ kFrameRows, kFrameCols } };
+				std::cout << (lazy ? "lazy" : "eager") << " create ";
+				PrintDuration(start_time); // <-- Finish.
+
+				[[maybe_unused]] bool ok{ frame.Draw({ 0, 0, kFrameRows - 1, kFrameCols - 1 }, 4) }; // (Whole cols: no initialization.)
+
+				double coverage{ 0.0 };
+				ok = frame.ComputeCoverage({ 0, 0, kFrameRows - 1, kFrameCols - 1 }, coverage, 4);
+				std::cout << (lazy ? "lazy" : "eager") << " frame drawn whole: " << (coverage == 1.0 ? "ok" : "MISMATCH") << std::endl;
+				std::cout << std::endl;
+			}
+
+			// The draw of TestPerformance() (partial cols: the drawn cols are initialized first):
+			const Frame frame{ Frame::Lazy(kFrameRows, kFrameCols) };
+			[[maybe_unused]] const bool ok{ frame.Draw({ 1, 1, 524288, 1024 }, 4) };
+		}
+	}
+
+
+	// Let's verify weighted segments, then calibrate the CPUs and observe a few draws.
+	static void TestWeightedSegments()
+	{
+		std::cout << "**** test weighted segments: per core throughput: ****\n" << std::endl;
+
+		{
+			std::vector<std::pair<size_t, size_t>> segments(3);
+			PrepareWeightedSegments(103, { 2.0, 1.0, 1.0 }, segments); // (1 col each + 100 cols by 2:1:1.)
+			const bool proportional{ segments[0] == std::pair<size_t, size_t>{ 0, 50 } && segments[1] == std::pair<size_t, size_t>{ 51, 76 } && segments[2] == std::pair<size_t, size_t>{ 77, 102 } };
+			std::cout << "weighted segments (2:1:1): " << (proportional ? "ok" : "MISMATCH") << std::endl;
+
+			PrepareWeightedSegments(3, { 5.0, 0.0, 1.0 }, segments); // (At least 1 col each.)
+			const bool at_least_one{ segments[0].second == 0 && segments[1] == std::pair<size_t, size_t>{ 1, 1 } && segments[2].first == 2 };
+			std::cout << "weighted segments (1 col each at least): " << (at_least_one ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		{
+			const size_t slots{ GetThreadBudget().budget };
+			SegmentWeights& weights{ SegmentWeights::Get() };
+			weights.Calibrate(slots);
+
+			std::cout << "calibrated weights (" << slots << " CPUs):";
+			for (const double weight : weights.GetWeights(slots)) {
+				std::cout << " " << std::format("{:.2f}", weight);
+			}
+			std::cout << std::endl << std::endl;
+
+			constexpr size_t kRows = 65536, kCols = 4096;
+			const Frame weighted{ kRows, kCols }, equal{ kRows, kCols };
+			std::cout << std::endl;
+
+			for (int i = 0; i < 3; ++i) {
+				[[maybe_unused]] const bool ok{ weighted.Draw({ 0, 0, kRows - 1, kCols - 1 }, slots) };
+				std::cout << std::endl;
+			}
+
+			weights.Disable();
+			[[maybe_unused]] const bool ok{ equal.Draw({ 0, 0, kRows - 1, kCols - 1 }, slots) };
+
+			std::cout << "observed weights:";
+			for (const double weight : weights.GetWeights(slots)) {
+				std::cout << " " << std::format("{:.2f}", weight);
+			}
+			std::cout << std::endl;
+
+			const bool same{ std::ranges::equal(weighted.ConstView().Span(), equal.ConstView().Span()) };
+			std::cout << "weighted vs equal segments: " << (same ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+
+	// Let's verify the dynamic / guided chunks, then compare the schedules under interference.
+	static void TestSchedules()
+	{
+		std::cout << "**** test schedules: static / dynamic / guided chunks: ****\n" << std::endl;
+
+		constexpr std::array<SegmentSchedule, 3> kSchedules{ SegmentSchedule::kStatic, SegmentSchedule::kDynamic, SegmentSchedule::kGuided };
+
+		{
+			// Each col exactly once, each chunk within the cols (with more threads than the budget: the threads are real here):
+			for (const SegmentSchedule schedule : kSchedules) {
+				constexpr size_t kCols = 1000, kThreads = 4;
+				std::vector<char> visits(kCols, 0); // (Disjoint chunks: no synchronization.)
+				std::vector<size_t> chunks(kThreads, 0);
+				std::streambuf* const output{ std::cout.rdbuf(nullptr) }; // (Mute the static segments.)
+				RunChunks(kCols, kThreads, schedule, [&](const size_t i, const std::pair<size_t, size_t> chunk) {
+					for (size_t col = chunk.first; col <= chunk.second && col < kCols; ++col) {
+						++visits[col];
+					}
+					++chunks[i];
+				});
+				std::cout.rdbuf(output);
+				std::cout.clear();
+
+				const bool once{ std::ranges::all_of(visits, [](const char v) { return v == 1; }) };
+				std::cout << GetScheduleName(schedule) << " chunks (" << std::accumulate(chunks.begin(), chunks.end(), static_cast<size_t>(0)) << " chunks): " << (once ? "ok" : "MISMATCH") << std::endl;
+			}
+			std::cout << std::endl;
+
+			// The same frame for each schedule (with a tracked histogram: per thread counts over several chunks):
+			const Frame reference{ 1000, 300 };
+			for (const SegmentSchedule schedule : kSchedules) {
+				Frame frame{ 1000, 300 };
+				[[maybe_unused]] bool ok{ frame.TrackHistogram() };
+				ok = reference.Draw({ 10, 7, 900, 290 });
+				ok = frame.Draw({ 10, 7, 900, 290 }, 4, schedule);
+
+				Frame::CharHistogram histogram{};
+				ok = frame.ComputeHistogram({ 0, 0, 999, 299 }, histogram);
+				const bool same{ std::ranges::equal(reference.ConstView().Span(), frame.ConstView().Span()) && histogram == *frame.GetTrackedHistogram() };
+				std::cout << GetScheduleName(schedule) << " vs single thread frame: " << (same ? "ok" : "MISMATCH") << std::endl;
+				std::cout << std::endl;
+			}
+		}
+
+		{
+			// Under interference: a thread filling memory meanwhile (cache and memory bandwidth, a CPU), and the pages of
+			// the frame discarded before each draw (page faults, as cold cols: a kBlackZero frame of a PageResource, so
+			// Reset() gives its pages back to the OS instead of writing them, see Frame::Reset()).
+			constexpr size_t kRows = 65536, kCols = 2048;
+			constexpr int kIterations = 5;
+			const size_t n{ GetThreadBudget().budget };
+
+			PageResource pages{};
+			Frame frame{ kRows, kCols, &pages, Frame::kDefaultAlignment, Frame::PixelEncoding::kBlackZero };
+			std::array<std::chrono::nanoseconds, kSchedules.size()> durations{};
+			{
+				std::jthread interference{ [](const std::stop_token stop) {
+					std::vector<char> buffer(32 * 1024 * 1024);
+					for (char value = 0; !stop.stop_requested(); ++value) {
+						std::memset(buffer.data(), value, buffer.size());
+					}
+				} };
+
+				std::streambuf* const output{ std::cout.rdbuf(nullptr) }; // (Mute the draws.)
+				for (int iteration = 0; iteration < kIterations; ++iteration) {
+					for (size_t s = 0; s < kSchedules.size(); ++s) {
+						[[maybe_unused]] bool ok{ frame.Reset() };
+						const auto start_time = Now();
+						ok = frame.Draw({ 0, 0, kRows - 1, kCols - 1 }, n, kSchedules[s]);
+						durations[s] += std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time);
+					}
+				}
+				std::cout.rdbuf(output);
+				std::cout.clear();
+			}
+
+			std::cout << kIterations << " draws (" << n << " threads, under interference):";
+			for (size_t s = 0; s < kSchedules.size(); ++s) {
+				std::cout << " " << GetScheduleName(kSchedules[s]) << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(durations[s]).count() << " milliseconds" << (s + 1 < kSchedules.size() ? "," : "");
+			}
+			std::cout << std::endl;
+		}
+	}
+
+
+	// Let's compare the execution backends: the same draws (large and small) on each.
+	static void TestBackends()
+	{
+		std::cout << "**** test execution backends: threads / worker pool / parallel algorithms / openmp: ****\n" << std::endl;
+
+		constexpr size_t kRows = 65536, kCols = 2048;
+		constexpr int kLargeDraws = 5, kSmallDraws = 2000;
+		const size_t n{ GetThreadBudget().budget };
+
+		const Frame reference{ kRows, kCols };
+		[[maybe_unused]] bool ok{ reference.Draw({ 3, 5, kRows - 7, kCols - 2 }) };
+		std::cout << std::endl;
+
+		for (const ExecutionBackend backend : { ExecutionBackend::kThreads, ExecutionBackend::kPool, ExecutionBackend::kParallelAlgorithms, ExecutionBackend::kOpenMP }) {
+			if (!IsBackendAvailable(backend)) {
+				std::cout << GetBackendName(backend) << ": not available in this build" << std::endl;
+				continue;
+			}
+			ok = SetExecutionBackend(backend);
+
+			const Frame frame{ kRows, kCols };
+			std::streambuf* const output{ std::cout.rdbuf(nullptr) }; // (Mute the draws.)
+
+			auto start_time = Now();
+			for (int i = 0; i < kLargeDraws; ++i) {
+				ok = frame.Draw({ 3, 5, kRows - 7, kCols - 2 }, n);
+			}
+			const auto large_duration = std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_time);
+
+			start_time = Now(); // (Small draws: the dispatch dominates.)
+			for (int i = 0; i < kSmallDraws; ++i) {
+				ok = frame.Draw({ 0, 0, 63, 63 }, n);
+			}
+			const auto small_duration = std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_time);
+
+			const Frame planned{ kRows, kCols }; // (Plans run on the backend too.)
+			DrawPlan::Compile(planned, FrameRect{ 3, 5, kRows - 7, kCols - 2 }, n).Execute();
+
+			std::cout.rdbuf(output);
+			std::cout.clear();
+
+			ok = reference.Draw({ 0, 0, 63, 63 }); // (The same chars drawn on both.)
+			const bool same{ std::ranges::equal(reference.ConstView().Span(), frame.ConstView().Span()) };
+			const bool planned_same{ std::ranges::equal(reference.ConstView().Span().subspan(64 * kRows), planned.ConstView().Span().subspan(64 * kRows)) }; // (Past the small draws.)
+
+			std::cout << GetBackendName(backend) << " (" << n << " threads): " << kLargeDraws << " large draws: " << large_duration.count() / 1000 << " milliseconds, "
+				<< kSmallDraws << " small draws: " << std::format("{:.2f}", static_cast<double>(small_duration.count()) / kSmallDraws) << " microseconds per draw, frame: " << (same ? "ok" : "MISMATCH") << ", plan: " << (planned_same ? "ok" : "MISMATCH") << std::endl;
+			std::cout << std::endl;
+		}
+
+		// Nested runs (from both the workers' and the calling thread's shares): the busy pool falls back to threads.
+		ok = SetExecutionBackend(ExecutionBackend::kPool);
+		std::array<std::array<char, 3>, 3> nested{}; // (Disjoint: no synchronization.)
+		RunParallel(3, [&](const size_t i) { RunParallel(3, [&](const size_t j) { ++nested[i][j]; }); });
+		const bool once{ std::ranges::all_of(nested, [](const auto& runs) { return std::ranges::all_of(runs, [](const char r) { return r == 1; }); }) };
+		std::cout << "worker pool nested runs: " << (once ? "ok" : "MISMATCH") << std::endl;
+
+		ok = SetExecutionBackend(ExecutionBackend::kThreads);
+		std::cout << "worker pool threads: " << WorkerPool::Get().GetWorkerCount() << std::endl;
+	}
+
+
+	// Let's measure the dispatch + join latency of small runs: jthreads vs the worker pool, by spin budget.
+	static void TestCompletionBarrier()
+	{
+		std::cout << "**** test completion barrier: spin then park, dispatch + join latency: ****\n" << std::endl;
+
+		constexpr int kRuns = 1000;
+		const size_t n{ std::max(GetThreadBudget().budget, static_cast<size_t>(2)) }; // (At least a worker.)
+		std::vector<std::array<char, 4096>> buffers(n); // (A small fill per thread: ~1 microsecond.)
+
+		// Latencies (microseconds): p50 / p90 / p99 / max.
+		const auto print_latencies = [](const char* name, std::vector<std::chrono::nanoseconds>& latencies) {
+			std::ranges::sort(latencies);
+			const auto percentile = [&](const double p) { return static_cast<double>(latencies[static_cast<size_t>(p * (latencies.size() - 1))].count()) / 1000; };
+			std::cout << name << ": p50: " << std::format("{:.1f}", percentile(0.5)) << ", p90: " << std::format("{:.1f}", percentile(0.9))
+				<< ", p99: " << std::format("{:.1f}", percentile(0.99)) << ", max: " << std::format("{:.1f}", percentile(1.0)) << " microseconds";
+		};
+
+		const auto measure = [&]() {
+			std::vector<std::chrono::nanoseconds> latencies(kRuns);
+			std::vector<size_t> runs(n, 0);
+			for (auto& latency : latencies) {
+				const auto start_time = Now();
+				RunParallel(n, [&](const size_t i) { std::memset(buffers[i].data(), static_cast<int>(i), buffers[i].size()); ++runs[i]; });
+				latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time);
+			}
+			const bool all{ std::ranges::all_of(runs, [&](const size_t count) { return count == kRuns; }) };
+
+			return std::pair{ latencies, all };
+		};
+
+		std::cout << kRuns << " runs (" << n << " threads):" << std::endl;
+
+		{
+			[[maybe_unused]] const bool ok{ SetExecutionBackend(ExecutionBackend::kThreads) };
+			auto [latencies, all] = measure();
+			print_latencies("threads", latencies);
+			std::cout << ", runs: " << (all ? "ok" : "MISMATCH") << std::endl;
+		}
+
+		[[maybe_unused]] bool ok{ SetExecutionBackend(ExecutionBackend::kPool) };
+		WorkerPool& pool{ WorkerPool::Get() };
+		for (const size_t spin_budget : { static_cast<size_t>(0), static_cast<size_t>(256), SpinParkBarrier::kDefaultSpinBudget, static_cast<size_t>(65536) }) {
+			pool.SetSpinBudget(spin_budget);
+			pool.GetCompletion().ResetStats();
+
+			auto [latencies, all] = measure();
+			const std::string name{ "worker pool (spin budget: " + std::to_string(spin_budget) + ")" };
+			print_latencies(name.c_str(), latencies);
+
+			const SpinParkBarrier::Stats stats{ pool.GetCompletion().GetStats() };
+			std::cout << ", spun: " << stats.spun << ", parked: " << stats.parked << ", runs: " << (all && stats.waits == kRuns ? "ok" : "MISMATCH") << std::endl;
+		}
+
+		pool.SetSpinBudget(SpinParkBarrier::kDefaultSpinBudget);
+		ok = SetExecutionBackend(ExecutionBackend::kThreads);
+	}
+
+
+	// Let's pipeline a draw and an encoder: the encoder reads each stripe as soon as it is drawn (vs after the whole draw).
+	static void TestStripes()
+	{
+		std::cout << "**** test stripes: draw then encode, pipelined per stripe: ****\n" << std::endl;
+
+		constexpr size_t kRows = 65536, kCols = 2048, kStripeCols = 32;
+		const size_t n{ GetThreadBudget().budget };
+
+		// The "encoder": a checksum of the drawn chars of a stripe.
+		const auto encode = [](const ConstFrameView& view, const Frame::Rect& stripe) {
+			uint64_t checksum{ 0 };
+			for (size_t col = stripe.y1; col <= stripe.y2; ++col) {
+				const auto chars{ view.Col(col).subspan(stripe.x1, stripe.x2 - stripe.x1 + 1) };
+				checksum += std::accumulate(chars.begin(), chars.end(), static_cast<uint64_t>(0), [](const uint64_t sum, const char c) { return sum * 31 + static_cast<unsigned char>(c); });
+			}
+
+			return checksum;
+		};
+
+		// Draw then encode:
+		uint64_t serial_checksum{ 0 };
+		std::chrono::nanoseconds serial_duration{};
+		{
+			const Frame frame{ kRows, kCols };
+			const ConstFrameView view{ frame.ConstView() };
+
+			const auto start_time = Now();
+			[[maybe_unused]] const bool ok{ frame.Draw({ 100, 0, kRows - 101, kCols - 1 }, n) };
+			for (size_t col = 0; col < kCols; col += kStripeCols) {
+				serial_checksum += encode(view, { 100, col, kRows - 101, col + kStripeCols - 1 });
+			}
+			serial_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time);
+			std::cout << std::endl;
+		}
+
+		// Pipelined: the stripes go through a completion queue to the encoder thread:
+		{
+			Frame frame{ kRows, kCols };
+			const ConstFrameView view{ frame.ConstView() };
+
+			BoundedQueue<Frame::Rect> completed{ kCols / kStripeCols + n }; // (Every stripe fits: the drawing threads never wait.)
+			frame.SetStripeCallback([&](const Frame::Rect& stripe) {
+				while (!completed.TryPush(stripe)) {
+					std::this_thread::yield();
+				}
+			}, kStripeCols);
+
+			std::atomic<bool> drawn{ false };
+			uint64_t pipelined_checksum{ 0 };
+			size_t encoded_cols{ 0 }, encoded_while_drawing{ 0 };
+
+			const auto start_time = Now();
+			std::jthread encoder{ [&]() {
+				for (Frame::Rect stripe{}; encoded_cols < kCols;) {
+					if (!completed.TryPop(stripe)) {
+						std::this_thread::yield();
+						continue;
+					}
+					encoded_while_drawing += drawn.load(std::memory_order_relaxed) ? 0 : 1;
+					pipelined_checksum += encode(view, stripe);
+					encoded_cols += stripe.y2 - stripe.y1 + 1;
+				}
+			} };
+
+			[[maybe_unused]] bool ok{ frame.Draw({ 100, 0, kRows - 101, kCols - 1 }, n) };
+			drawn.store(true, std::memory_order_relaxed);
+			encoder.join();
+			const auto pipelined_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - start_time);
+
+			const auto to_ms = [](const auto duration) { return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(); };
+			std::cout << "draw then encode: " << to_ms(serial_duration) << " milliseconds, pipelined: " << to_ms(pipelined_duration) << " milliseconds ("
+				<< encoded_while_drawing << " of " << kCols / kStripeCols << " stripes encoded while drawing)" << std::endl;
+			std::cout << "pipelined checksum: " << (pipelined_checksum == serial_checksum && encoded_cols == kCols ? "ok" : "MISMATCH") << std::endl;
+
+			// Stripes within the clip region, with a tracked histogram:
+			ok = frame.Reset();
+			ok = frame.TrackHistogram();
+			ok = frame.PushClip(Frame::Rect{ 10, 10, 500, 300 });
+
+			std::vector<Frame::Rect> stripes;
+			std::mutex stripes_mutex;
+			frame.SetStripeCallback([&](const Frame::Rect& stripe) { std::scoped_lock lock{ stripes_mutex }; stripes.push_back(stripe); }, 100);
+			ok = frame.Draw({ 0, 0, 1000, 1000 }, n);
+			frame.SetStripeCallback({});
+			ok = frame.PopClip();
+
+			std::ranges::sort(stripes, {}, &Frame::Rect::y1);
+			size_t next_col{ 10 };
+			bool contiguous{ true };
+			for (const Frame::Rect& stripe : stripes) {
+				contiguous = contiguous && stripe.y1 == next_col && stripe.y2 - stripe.y1 < 100 && stripe.x1 == 10 && stripe.x2 == 500;
+				next_col = stripe.y2 + 1;
+			}
+			std::cout << "clipped stripes (" << stripes.size() << "): " << (contiguous && next_col == 301 ? "ok" : "MISMATCH") << std::endl;
+
+			// Stripes of a clip region with a gap: the threads split (and the stripes cover) the visible cols only:
+			ok = frame.Reset();
+			const std::array<Frame::Rect, 2> gapped_clip{ Frame::Rect{ 10, 0, 500, 9 }, Frame::Rect{ 10, 990, 500, 999 } };
+			ok = frame.PushClip(gapped_clip);
+
+			stripes.clear();
+			frame.SetStripeCallback([&](const Frame::Rect& stripe) { std::scoped_lock lock{ stripes_mutex }; stripes.push_back(stripe); }, 100);
+			ok = frame.Draw({ 0, 0, 1000, 1000 }, 4);
+			frame.SetStripeCallback({});
+			ok = frame.PopClip();
+
+			const auto is_visible = [](const size_t col) { return col <= 9 || (col >= 990 && col <= 999); };
+			size_t stripe_cols{ 0 };
+			bool visible{ true };
+			for (const Frame::Rect& stripe : stripes) {
+				visible = visible && is_visible(stripe.y1) && is_visible(stripe.y2) && stripe.y1 + 9 >= stripe.y2;
+				stripe_cols += stripe.y2 - stripe.y1 + 1;
+			}
+			const auto drawn_chars = [&](const size_t col) { return view.Col(col).subspan(10, 491); };
+			bool drawn_visible{ true };
+			for (const size_t col : { size_t{ 0 }, size_t{ 9 }, size_t{ 10 }, size_t{ 500 }, size_t{ 989 }, size_t{ 990 }, size_t{ 999 } }) {
+				drawn_visible = drawn_visible && std::ranges::equal(drawn_chars(col), drawn_chars(0)) == is_visible(col);
+			}
+			std::cout << "gapped clip stripes (" << stripes.size() << "): " << (visible && stripe_cols == 20 && drawn_visible ? "ok" : "MISMATCH") << std::endl;
+		}
+	}
+
+} // (Anonymous namespace)
 
 
 int main()
@@ -412,4 +5574,50 @@ int main()
 	TestFunctionality();
 	std::cout << std::endl;
 	TestPerformance();
+	std::cout << std::endl;
+	TestConvolution();
+	std::cout << std::endl;
+	TestStatistics();
+	std::cout << std::endl;
+	TestTiledFrame();
+	std::cout << std::endl;
+	TestSnapshot();
+	std::cout << std::endl;
+	TestFramePool();
+	std::cout << std::endl;
+	TestMemoryResources();
+	std::cout << std::endl;
+	TestHandoff();
+	std::cout << std::endl;
+	TestFrameView();
+	std::cout << std::endl;
+	TestFixedFrame();
+	std::cout << std::endl;
+	TestDrawPlan();
+	std::cout << std::endl;
+	TestDrawQueue();
+	std::cout << std::endl;
+	TestFrameScheduler();
+	std::cout << std::endl;
+	TestOverdraw();
+	std::cout << std::endl;
+	TestDisplayList();
+	std::cout << std::endl;
+	TestCompositor();
+	std::cout << std::endl;
+	TestClip();
+	std::cout << std::endl;
+	TestZeroPageReset();
+	std::cout << std::endl;
+	TestLazyFrame();
+	std::cout << std::endl;
+	TestWeightedSegments();
+	std::cout << std::endl;
+	TestSchedules();
+	std::cout << std::endl;
+	TestBackends();
+	std::cout << std::endl;
+	TestCompletionBarrier();
+	std::cout << std::endl;
+	TestStripes();
 }
\ No newline at end of file